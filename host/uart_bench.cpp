@@ -0,0 +1,245 @@
+/**
+ * @file uart_bench.cpp
+ * @brief Throughput and latency benchmark for the UART link.
+ *
+ * This program measures echo throughput and round-trip latency through a uart::Peer. Without a device it creates a pty pair and echoes on the master side, otherwise the remote (AVR firmware or a host build of it) has to echo every received byte.
+ *
+ * Usage: uart_bench [--device PATH] [--baud RATE] [--bytes N] [--message N] [--iterations N]
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_peer.hpp for the serial peer.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_peer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string device;
+        unsigned long baudrate = 115200;
+        std::size_t bytes = 1 << 20;
+        std::size_t message = 16;
+        std::size_t iterations = 1000;
+    };
+
+    /**
+     * @brief Echo loop on the pty master, stands in for the firmware side.
+     */
+    void echo(int fd, std::atomic<bool> &running)
+    {
+        std::vector<char> buffer(4096);
+        pollfd event{ fd, POLLIN, 0 };
+
+        while (running)
+        {
+            if (::poll(&event, 1, 50) <= 0)
+            {
+                continue;
+            }
+
+            ssize_t length = ::read(fd, buffer.data(), buffer.size());
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                ssize_t result = ::write(fd, buffer.data() + offset, static_cast<std::size_t>(length - offset));
+
+                if (result > 0)
+                {
+                    offset += result;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Send bytes and receive the echo at the same time.
+     */
+    double throughput(uart::Peer &peer, const Options &options)
+    {
+        std::vector<std::uint8_t> chunk(options.message);
+        std::size_t sent = 0;
+        std::size_t received = 0;
+
+        for (std::size_t i = 0; i < chunk.size(); i++)
+        {
+            chunk[i] = static_cast<std::uint8_t>('A' + (i % 26));
+        }
+
+        auto start = Clock::now();
+
+        while (received < options.bytes)
+        {
+            if (sent < options.bytes)
+            {
+                std::size_t length = std::min(chunk.size(), options.bytes - sent);
+
+                peer.write(chunk.data(), length);
+                sent += length;
+            }
+
+            peer.poll(sent < options.bytes ? 0 : 1000);
+
+            uart::View pending = peer.view();
+            received += pending.size;
+            peer.consume(pending.size);
+        }
+
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        return static_cast<double>(options.bytes) / elapsed.count();
+    }
+
+    /**
+     * @brief Measure the round-trip time of single messages.
+     */
+    std::vector<double> latency(uart::Peer &peer, const Options &options)
+    {
+        std::vector<std::uint8_t> message(options.message, 'L');
+        std::vector<double> samples;
+
+        samples.reserve(options.iterations);
+
+        for (std::size_t i = 0; i < options.iterations; i++)
+        {
+            std::size_t received = 0;
+            auto start = Clock::now();
+
+            peer.write(message.data(), message.size());
+
+            while (received < message.size())
+            {
+                if (!peer.poll(1000))
+                {
+                    std::fprintf(stderr, "timeout waiting for echo\n");
+                    std::exit(EXIT_FAILURE);
+                }
+
+                uart::View pending = peer.view();
+                received += pending.size;
+                peer.consume(pending.size);
+            }
+
+            std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+            samples.push_back(elapsed.count());
+        }
+
+        std::sort(samples.begin(), samples.end());
+        return samples;
+    }
+
+    Options arguments(int argc, char **argv)
+    {
+        Options options;
+
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            std::string name = argv[i];
+
+            if (name == "--device")
+            {
+                options.device = argv[i + 1];
+            }
+            else if (name == "--baud")
+            {
+                options.baudrate = std::strtoul(argv[i + 1], nullptr, 10);
+            }
+            else if (name == "--bytes")
+            {
+                options.bytes = std::strtoul(argv[i + 1], nullptr, 10);
+            }
+            else if (name == "--message")
+            {
+                options.message = std::max<std::size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+            }
+            else if (name == "--iterations")
+            {
+                options.iterations = std::max<std::size_t>(1, std::strtoul(argv[i + 1], nullptr, 10));
+            }
+            else
+            {
+                std::fprintf(stderr, "usage: %s [--device PATH] [--baud RATE] [--bytes N] [--message N] [--iterations N]\n", argv[0]);
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options = arguments(argc, argv);
+    std::atomic<bool> running(true);
+    std::thread responder;
+    int master = -1;
+
+    if (options.device.empty())
+    {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+        if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0)
+        {
+            std::perror("posix_openpt");
+            return EXIT_FAILURE;
+        }
+
+        options.device = ::ptsname(master);
+        responder = std::thread(echo, master, std::ref(running));
+    }
+
+    uart::Config config;
+    config.baudrate = options.baudrate;
+
+    uart::Peer peer(options.device, config);
+
+    double rate = throughput(peer, options);
+    std::vector<double> samples = latency(peer, options);
+
+    running = false;
+
+    if (responder.joinable())
+    {
+        responder.join();
+        ::close(master);
+    }
+
+    double sum = 0.0;
+
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+
+    std::printf("device      %s\n", options.device.c_str());
+    std::printf("throughput  %.0f bytes/s (%zu bytes, %zu byte writes)\n", rate, options.bytes, options.message);
+    std::printf("latency     min %.1f us, avg %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us (%zu x %zu bytes)\n",
+                samples.front(), sum / static_cast<double>(samples.size()), samples[samples.size() / 2],
+                samples[(samples.size() * 99) / 100], samples.back(), samples.size(), options.message);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file uart_firmware.c
+ * @brief Host build of the firmware side of the link benchmark.
+ *
+ * This program runs uart.c with the register stubs of the host checks behind a pty. Bytes written by the peer enter ISR(UART_RXC_vect), the main loop echoes them with uart_scanchar()/uart_putchar() through both queues and ISR(UART_UDRE_vect) hands the transmitted bytes back to the pty. uart_bench then measures the driver code path instead of a plain echo.
+ *
+ * Usage: uart_firmware, prints the pty slave path and echoes until it is terminated.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_bench.cpp for the benchmark.
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "uart.h"
+
+#if UART_TX_BUFFER_SIZE == 0 || UART_RX_BUFFER_SIZE == 0
+    #error "uart_firmware requires both queues"
+#endif
+
+void UART_RXC_vect(void);
+void UART_UDRE_vect(void);
+
+/**
+ * @brief Hand the transmitted bytes to the pty.
+ */
+static void transmit(int fd)
+{
+    char data[UART_TX_BUFFER_SIZE];
+    size_t count = 0;
+
+    while ((UCSRB & (1<<UDRIE)) && count < sizeof(data))
+    {
+        // The driver clears TXC (writes a one) right before it writes UDR, the stub keeps the one
+        UCSRA &= ~(1<<TXC);
+        UART_UDRE_vect();
+
+        if (UCSRA & (1<<TXC))
+        {
+            data[count++] = (char)UDR;
+        }
+    }
+
+    for (size_t offset = 0; offset < count;)
+    {
+        ssize_t result = write(fd, data + offset, count - offset);
+
+        if (result > 0)
+        {
+            offset += (size_t)result;
+        }
+    }
+}
+
+int main(void)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0)
+    {
+        perror("posix_openpt");
+        return EXIT_FAILURE;
+    }
+
+    printf("%s\n", ptsname(master));
+    fflush(stdout);
+
+    uart_init();
+
+    for (;;)
+    {
+        unsigned char buffer[256];
+        struct pollfd event = { master, POLLIN, 0 };
+
+        if (poll(&event, 1, -1) <= 0)
+        {
+            continue;
+        }
+
+        ssize_t length = read(master, buffer, sizeof(buffer));
+
+        for (ssize_t i = 0; i < length; i++)
+        {
+            char data;
+
+            UCSRA |= (1<<RXC);
+            UDR = buffer[i];
+            UART_RXC_vect();
+            UCSRA &= ~(1<<RXC);
+
+            // Firmware main loop
+            while (uart_scanchar(&data) == UART_Received)
+            {
+                uart_putchar(data);
+            }
+            transmit(master);
+        }
+    }
+}
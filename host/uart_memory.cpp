@@ -0,0 +1,216 @@
+/**
+ * @file uart_memory.cpp
+ * @brief Source file with implementation of the host side of the remote memory access methods.
+ *
+ * This file contains the block splitting and response collection of the memory client. The argument layout is the one of uart_memory.h: space (1 byte), address (2 bytes, little-endian), then length (read) or data (write).
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_memory.hpp for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_memory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace uart
+{
+    namespace
+    {
+        const std::size_t header = 3;           // RPC request header
+        const std::size_t arguments = 3;        // Space and address
+    }
+
+    /**
+     * @brief Create a memory client.
+     *
+     * @param rpc RPC client of the device.
+     * @param read_method Method number of uart_memory_read().
+     * @param write_method Method number of uart_memory_write().
+     * @param max_frame Largest request frame payload the firmware accepts (UART_FRAME_RX_MAX).
+     * @param window Receive queue of the firmware in bytes (UART_RX_BUFFER_SIZE - 1), frames beyond it are discarded by the firmware.
+     * @param max_read Largest block of one read request (max 255, 252 with a 1 byte frame length prefix).
+     *
+     * @throws std::invalid_argument if a frame or the window cannot hold one byte of data.
+     */
+    MemoryClient::MemoryClient(RpcClient &rpc, std::uint8_t read_method, std::uint8_t write_method, std::size_t max_frame, std::size_t window, std::size_t max_read)
+        : rpc_(rpc), read_method_(read_method), write_method_(write_method), max_read_(std::min<std::size_t>(max_read, 255)), window_(window), offsets_(256), sizes_(256), costs_(256), active_(256)
+    {
+        const Config &config = rpc_.peer().config();
+
+        overhead_ = config.frame_length_bytes + (config.frame_crc ? 2 : 0);
+
+        if (max_frame <= header + arguments || window_ <= overhead_ + header + arguments || !max_read_)
+        {
+            throw std::invalid_argument("max_frame/window/max_read too small");
+        }
+        max_write_ = std::min<std::size_t>({ max_frame - header - arguments, window_ - overhead_ - header - arguments, 255 - arguments });
+    }
+
+    /**
+     * @brief Read a memory block of the device.
+     *
+     * @param space Memory space.
+     * @param address First address.
+     * @param[out] data Buffer of length bytes.
+     * @param length Number of bytes.
+     * @param timeout_ms Timeout for every response in milliseconds (-1 = infinite).
+     * @return true if all blocks have been read.
+     */
+    bool MemoryClient::read(UART_Memory_Space space, std::uint16_t address, void *data, std::size_t length, int timeout_ms)
+    {
+        std::uint8_t *bytes = static_cast<std::uint8_t *>(data);
+        std::size_t offset = 0;
+
+        while (offset < length)
+        {
+            std::size_t size = std::min(max_read_, length - offset);
+            std::uint16_t block = static_cast<std::uint16_t>(address + offset);
+            std::uint8_t args[] = {
+                static_cast<std::uint8_t>(space), static_cast<std::uint8_t>(block), static_cast<std::uint8_t>(block >> 8), static_cast<std::uint8_t>(size)
+            };
+            std::size_t cost = overhead_ + header + sizeof(args);
+
+            // Wait until the receive queue of the firmware has room for the request
+            if (pending_ + cost > window_ && !collect(bytes, window_ - cost, timeout_ms))
+            {
+                return false;
+            }
+
+            int id = rpc_.call(read_method_, args, sizeof(args));
+
+            // All IDs in flight, complete the current batch first
+            if (id < 0)
+            {
+                if (!collect(bytes, 0, timeout_ms))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            offsets_[id] = offset;
+            sizes_[id] = size;
+            costs_[id] = cost;
+            active_[id] = true;
+            pending_ += cost;
+            offset += size;
+        }
+        return collect(bytes, 0, timeout_ms);
+    }
+
+    /**
+     * @brief Write a memory block of the device.
+     *
+     * @param space Memory space (UART_MEMORY_RAM or UART_MEMORY_EEPROM).
+     * @param address First address.
+     * @param data Data to write.
+     * @param length Number of bytes.
+     * @param timeout_ms Timeout for every response in milliseconds (-1 = infinite).
+     * @return true if all blocks have been written.
+     *
+     * @note An EEPROM block is answered after it has been written (about 3.4 ms per byte), the default timeout covers the largest block.
+     */
+    bool MemoryClient::write(UART_Memory_Space space, std::uint16_t address, const void *data, std::size_t length, int timeout_ms)
+    {
+        const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+        std::uint8_t args[255];
+        std::size_t offset = 0;
+
+        while (offset < length)
+        {
+            std::size_t size = std::min(max_write_, length - offset);
+            std::uint16_t block = static_cast<std::uint16_t>(address + offset);
+            std::size_t cost = overhead_ + header + arguments + size;
+
+            if (pending_ + cost > window_ && !collect(nullptr, window_ - cost, timeout_ms))
+            {
+                return false;
+            }
+
+            args[0] = static_cast<std::uint8_t>(space);
+            args[1] = static_cast<std::uint8_t>(block);
+            args[2] = static_cast<std::uint8_t>(block >> 8);
+            std::memcpy(&args[arguments], bytes + offset, size);
+
+            int id = rpc_.call(write_method_, args, arguments + size);
+
+            if (id < 0)
+            {
+                if (!collect(nullptr, 0, timeout_ms))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            sizes_[id] = 0;
+            costs_[id] = cost;
+            active_[id] = true;
+            pending_ += cost;
+            offset += size;
+        }
+        return collect(nullptr, 0, timeout_ms);
+    }
+
+    /**
+     * @brief Send the queued blocks and wait for responses until the requests without response fit into limit.
+     *
+     * @param[out] data Read buffer (nullptr for writes).
+     * @param limit Receive queue bytes that may stay occupied (0 = wait for all responses).
+     * @param timeout_ms Timeout for every response in milliseconds (-1 = infinite).
+     * @return true if every collected block has been answered with UART_RPC_OK.
+     *
+     * @details
+     * Every request is counted with its own frame (length prefix, CRC), batched requests share a frame, so the firmware never holds more than counted. Responses of blocks from an earlier, aborted transfer are skipped.
+     */
+    bool MemoryClient::collect(std::uint8_t *data, std::size_t limit, int timeout_ms)
+    {
+        bool result = rpc_.send(timeout_ms);
+        Response response;
+
+        while (result && pending_ > limit)
+        {
+            if (!rpc_.response(response, timeout_ms))
+            {
+                result = false;
+                break;
+            }
+
+            if (!active_[response.id])
+            {
+                continue;
+            }
+
+            active_[response.id] = false;
+            pending_ -= costs_[response.id];
+
+            if (response.status != UART_RPC_OK || response.result.size() != sizes_[response.id])
+            {
+                result = false;
+            }
+            else if (data)
+            {
+                std::memcpy(data + offsets_[response.id], response.result.data(), response.result.size());
+            }
+        }
+
+        // Responses of an aborted transfer are never matched
+        if (!result)
+        {
+            std::fill(active_.begin(), active_.end(), false);
+            pending_ = 0;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file uart_memory.hpp
+ * @brief Header file with declarations of the host side of the remote memory access methods.
+ *
+ * This file provides block read and write of device memory through uart_memory.c. A transfer is split into blocks that fit the frames of the firmware and the blocks are sent as batches of RPC requests that fit the receive queue of the firmware, so a calibration table takes few round trips and no request is dropped.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_MEMORY_HPP_
+#define UART_MEMORY_HPP_
+
+#include "uart_rpc.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart
+{
+    /**
+     * @brief Memory space, same values as UART_MEMORY_RAM/UART_MEMORY_EEPROM/UART_MEMORY_FLASH of uart_memory.h.
+     */
+    enum UART_Memory_Space
+    {
+        UART_MEMORY_RAM = 0,    /**< SRAM */
+        UART_MEMORY_EEPROM,     /**< EEPROM */
+        UART_MEMORY_FLASH       /**< Flash memory (read only) */
+    };
+
+    /**
+     * @brief Remote memory access on top of an RpcClient.
+     *
+     * @details
+     * read_method and write_method are the indices of uart_memory_read() and uart_memory_write() in the method table of the firmware. Requests without response never exceed the window, the next block is sent when responses have made room for it. A transfer fails as a whole if any block is denied, fails or times out, written blocks before the failing one stay written.
+     */
+    class MemoryClient
+    {
+    public:
+        MemoryClient(RpcClient &rpc, std::uint8_t read_method, std::uint8_t write_method, std::size_t max_frame, std::size_t window, std::size_t max_read = 252);
+
+        bool read(UART_Memory_Space space, std::uint16_t address, void *data, std::size_t length, int timeout_ms = 2000);
+        bool write(UART_Memory_Space space, std::uint16_t address, const void *data, std::size_t length, int timeout_ms = 2000);
+
+    private:
+        bool collect(std::uint8_t *data, std::size_t limit, int timeout_ms);
+
+        RpcClient &rpc_;
+        std::uint8_t read_method_;
+        std::uint8_t write_method_;
+        std::size_t max_read_;
+        std::size_t max_write_;
+        std::size_t window_;
+        std::size_t overhead_;                  // Frame length prefix and CRC
+        std::vector<std::size_t> offsets_;      // Data offset of a block by request ID
+        std::vector<std::size_t> sizes_;        // Data size of a block by request ID
+        std::vector<std::size_t> costs_;        // Receive queue bytes of a request by request ID
+        std::vector<bool> active_;              // Request ID belongs to the current transfer
+        std::size_t pending_ = 0;               // Receive queue bytes of the requests without response
+    };
+}
+
+#endif /* UART_MEMORY_HPP_ */
@@ -0,0 +1,839 @@
+/**
+ * @file uart_peer.cpp
+ * @brief Source file with implementation of the Linux host counterpart of the AVR UART driver.
+ *
+ * This file contains the termios configuration, the epoll based wait functions and the receive decoder of the serial peer. The decoder resolves PARMRK error marks and XON/XOFF characters in place while the data is moved into the frame buffer.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_peer.hpp for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_peer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace uart
+{
+    namespace
+    {
+        struct Speed
+        {
+            unsigned long baudrate;
+            speed_t speed;
+        };
+
+        const Speed speeds[] = {
+            { 1200, B1200 }, { 2400, B2400 }, { 4800, B4800 }, { 9600, B9600 },
+            { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 }, { 115200, B115200 },
+            { 230400, B230400 }, { 460800, B460800 }, { 500000, B500000 }, { 576000, B576000 },
+            { 921600, B921600 }, { 1000000, B1000000 }, { 1152000, B1152000 }, { 1500000, B1500000 },
+            { 2000000, B2000000 }, { 2500000, B2500000 }, { 3000000, B3000000 }, { 3500000, B3500000 },
+            { 4000000, B4000000 }
+        };
+
+        // CRC-16/XMODEM, same as _crc_xmodem_update() of avr-libc
+        std::uint16_t crc_xmodem(std::uint16_t crc, const std::uint8_t *data, std::size_t length)
+        {
+            while (length--)
+            {
+                crc ^= static_cast<std::uint16_t>(*data++) << 8;
+
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+                }
+            }
+            return crc;
+        }
+
+        std::system_error system_error(const std::string &what)
+        {
+            return std::system_error(errno, std::generic_category(), what);
+        }
+
+        // Remaining milliseconds until deadline (-1 = infinite)
+        int remaining(std::chrono::steady_clock::time_point deadline, int timeout_ms)
+        {
+            if (timeout_ms < 0)
+            {
+                return -1;
+            }
+
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            return left > 0 ? static_cast<int>(left) : 0;
+        }
+    }
+
+    /**
+     * @brief Create a frame buffer.
+     *
+     * @param size Capacity in bytes.
+     */
+    FrameBuffer::FrameBuffer(std::size_t size) : buffer_(size)
+    {
+    }
+
+    /**
+     * @brief Get the writable tail of the buffer.
+     *
+     * @param[in,out] length Minimum number of bytes requested, returns the number of writable bytes.
+     * @return Pointer to the first writable byte.
+     *
+     * @details
+     * Unread data is moved to the front only if the tail is smaller than requested.
+     */
+    std::uint8_t *FrameBuffer::space(std::size_t &length)
+    {
+        if ((buffer_.size() - tail_) < length && head_)
+        {
+            std::memmove(buffer_.data(), buffer_.data() + head_, tail_ - head_);
+            tail_ -= head_;
+            head_ = 0;
+        }
+
+        length = buffer_.size() - tail_;
+        return buffer_.data() + tail_;
+    }
+
+    /**
+     * @brief Append bytes that have been written to space().
+     *
+     * @param length Number of bytes written.
+     */
+    void FrameBuffer::produced(std::size_t length)
+    {
+        tail_ += length;
+    }
+
+    /**
+     * @brief Get a view of all unread bytes.
+     */
+    View FrameBuffer::view() const
+    {
+        return View{ buffer_.data() + head_, tail_ - head_ };
+    }
+
+    /**
+     * @brief Mark bytes as read.
+     *
+     * @param length Number of bytes to release from the front.
+     */
+    void FrameBuffer::consume(std::size_t length)
+    {
+        head_ += std::min(length, tail_ - head_);
+
+        if (head_ == tail_)
+        {
+            head_ = 0;
+            tail_ = 0;
+        }
+    }
+
+    /**
+     * @brief Number of unread bytes.
+     */
+    std::size_t FrameBuffer::size() const
+    {
+        return tail_ - head_;
+    }
+
+    /**
+     * @brief Open and configure a serial device.
+     *
+     * @param path Device path (e.g. /dev/ttyUSB0 or a pty slave).
+     * @param config Line configuration.
+     */
+    Peer::Peer(const std::string &path, const Config &config) : config_(config), rx_(config.buffer_size)
+    {
+        fd_ = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+        if (fd_ < 0)
+        {
+            throw system_error("open " + path);
+        }
+
+        try
+        {
+            configure();
+
+            epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+
+            if (epoll_ < 0)
+            {
+                throw system_error("epoll_create1");
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd_;
+
+            if (::epoll_ctl(epoll_, EPOLL_CTL_ADD, fd_, &event) < 0)
+            {
+                throw system_error("epoll_ctl");
+            }
+        }
+        catch (...)
+        {
+            if (epoll_ >= 0)
+            {
+                ::close(epoll_);
+            }
+            ::close(fd_);
+            throw;
+        }
+
+        // Error counters are optional (not available on pty devices)
+        serial_icounter_struct icount{};
+
+        if (::ioctl(fd_, TIOCGICOUNT, &icount) == 0)
+        {
+            icount_ = true;
+            frame_count_ = icount.frame + icount.brk;
+            overrun_count_ = icount.overrun + icount.buf_overrun;
+            parity_count_ = icount.parity;
+        }
+    }
+
+    Peer::~Peer()
+    {
+        ::close(epoll_);
+        ::close(fd_);
+    }
+
+    /**
+     * @brief Apply the line configuration (raw mode, frame format, speed, flow control).
+     */
+    void Peer::configure()
+    {
+        termios tty{};
+
+        if (::tcgetattr(fd_, &tty) < 0)
+        {
+            throw system_error("tcgetattr");
+        }
+
+        ::cfmakeraw(&tty);
+
+        tty.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+        tty.c_cflag |= CLOCAL | CREAD;
+
+        switch (config_.datasize)
+        {
+            case 5: tty.c_cflag |= CS5; break;
+            case 6: tty.c_cflag |= CS6; break;
+            case 7: tty.c_cflag |= CS7; break;
+            case 8: tty.c_cflag |= CS8; break;
+            default: throw std::invalid_argument("datasize has to be 5-8");
+        }
+
+        if (config_.parity)
+        {
+            tty.c_cflag |= PARENB | (config_.parity == 2 ? PARODD : 0);
+            tty.c_iflag |= INPCK;
+        }
+
+        if (config_.stopbits > 1)
+        {
+            tty.c_cflag |= CSTOPB;
+        }
+
+        if (config_.handshake == 2)
+        {
+            tty.c_cflag |= CRTSCTS;
+        }
+
+        // Mark frame/parity errors and breaks as 0xFF 0x00 <byte>, XON/XOFF is handled by the peer itself
+        tty.c_iflag &= ~(IGNPAR | IGNBRK | BRKINT | ISTRIP | IXON | IXOFF | IXANY);
+        tty.c_iflag |= PARMRK;
+
+        tty.c_cc[VMIN] = 0;
+        tty.c_cc[VTIME] = 0;
+
+        const Speed *speed = std::find_if(std::begin(speeds), std::end(speeds), [this](const Speed &entry) { return entry.baudrate == config_.baudrate; });
+
+        if (speed == std::end(speeds))
+        {
+            throw std::invalid_argument("unsupported baudrate");
+        }
+
+        ::cfsetispeed(&tty, speed->speed);
+        ::cfsetospeed(&tty, speed->speed);
+
+        if (::tcsetattr(fd_, TCSANOW, &tty) < 0)
+        {
+            throw system_error("tcsetattr");
+        }
+        ::tcflush(fd_, TCIOFLUSH);
+    }
+
+    /**
+     * @brief Wait for events on the device.
+     *
+     * @param events EPOLLIN and/or EPOLLOUT.
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return true if one of the events occurred.
+     */
+    bool Peer::wait(std::uint32_t events, int timeout_ms)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd_;
+
+        if (events != EPOLLIN && ::epoll_ctl(epoll_, EPOLL_CTL_MOD, fd_, &event) < 0)
+        {
+            throw system_error("epoll_ctl");
+        }
+
+        int result;
+
+        do
+        {
+            result = ::epoll_wait(epoll_, &event, 1, timeout_ms);
+        } while (result < 0 && errno == EINTR);
+
+        if (events != EPOLLIN)
+        {
+            epoll_event restore{};
+            restore.events = EPOLLIN;
+            restore.data.fd = fd_;
+            ::epoll_ctl(epoll_, EPOLL_CTL_MOD, fd_, &restore);
+        }
+
+        if (result < 0)
+        {
+            throw system_error("epoll_wait");
+        }
+        return result > 0;
+    }
+
+    /**
+     * @brief Remove PARMRK error marks and XON/XOFF characters in place.
+     *
+     * @param data Freshly read bytes at the tail of the frame buffer.
+     * @param length Number of bytes read.
+     *
+     * @details
+     * Same behaviour as the receive ISR of the driver: a faulty byte is discarded and the error is latched, flow control characters update the remote state and are not stored.
+     */
+    void Peer::decode(std::uint8_t *data, std::size_t length)
+    {
+        std::uint8_t *target = data;
+
+        for (std::size_t i = 0; i < length; i++)
+        {
+            std::uint8_t byte = data[i];
+
+            if (mark_ == 1)
+            {
+                if (byte == 0x00)
+                {
+                    mark_ = 2;
+                    continue;
+                }
+                mark_ = 0;                  // 0xFF 0xFF = literal 0xFF
+            }
+            else if (mark_ == 2)
+            {
+                mark_ = 0;
+
+                // 0xFF 0x00 0x00 is a break, otherwise frame or parity error
+                error_ = (byte && config_.parity) ? UART_Parity : UART_Frame;
+                continue;
+            }
+            else if (byte == 0xFF)
+            {
+                mark_ = 1;
+                continue;
+            }
+
+            if (config_.handshake == 1)
+            {
+                if (byte == config_.xon)
+                {
+                    remote_ = UART_Ready;
+                    continue;
+                }
+                else if (byte == config_.xoff)
+                {
+                    remote_ = UART_Pause;
+                    continue;
+                }
+            }
+            *target++ = byte;
+        }
+        rx_.produced(static_cast<std::size_t>(target - data));
+    }
+
+    /**
+     * @brief Refine latched errors with the serial icounters of the device.
+     */
+    void Peer::counters()
+    {
+        serial_icounter_struct icount{};
+
+        if (!icount_ || ::ioctl(fd_, TIOCGICOUNT, &icount) < 0)
+        {
+            return;
+        }
+
+        unsigned long frame = icount.frame + icount.brk;
+        unsigned long overrun = icount.overrun + icount.buf_overrun;
+        unsigned long parity = icount.parity;
+
+        if (overrun != overrun_count_)
+        {
+            error_ = UART_Overrun;
+        }
+        else if (parity != parity_count_)
+        {
+            error_ = UART_Parity;
+        }
+        else if (frame != frame_count_)
+        {
+            error_ = UART_Frame;
+        }
+
+        frame_count_ = frame;
+        overrun_count_ = overrun;
+        parity_count_ = parity;
+    }
+
+    /**
+     * @brief Read all pending bytes into the frame buffer.
+     *
+     * @param timeout_ms Time to wait for the first byte (0 = no wait, -1 = infinite).
+     * @return Number of bytes appended to the frame buffer.
+     */
+    std::size_t Peer::poll(int timeout_ms)
+    {
+        std::size_t total = 0;
+
+        if (timeout_ms && !wait(EPOLLIN, timeout_ms))
+        {
+            return 0;
+        }
+
+        for (;;)
+        {
+            std::size_t length = 256;
+            std::uint8_t *space = rx_.space(length);
+
+            if (!length)
+            {
+                break;                      // Frame buffer full, remaining data stays in the kernel
+            }
+
+            ssize_t result = ::read(fd_, space, length);
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EIO)
+                {
+                    break;                  // EIO: pty without peer
+                }
+                throw system_error("read");
+            }
+
+            if (result == 0)
+            {
+                break;
+            }
+
+            std::size_t before = rx_.size();
+            decode(space, static_cast<std::size_t>(result));
+            total += rx_.size() - before;
+        }
+
+        counters();
+        return total;
+    }
+
+    /**
+     * @brief Non-blocking receive of one character (mirror of uart_scanchar()).
+     *
+     * @param[out] data Received character (0 on UART_Fault).
+     * @return UART_Empty, UART_Received or UART_Fault.
+     */
+    UART_Data Peer::scanchar(char &data)
+    {
+        if (!rx_.size())
+        {
+            poll(0);
+        }
+
+        if (error_ != UART_None)
+        {
+            error_ = UART_None;
+            data = 0;
+            return UART_Fault;
+        }
+
+        View pending = rx_.view();
+
+        if (!pending.size)
+        {
+            return UART_Empty;
+        }
+
+        data = static_cast<char>(pending.data[0]);
+        rx_.consume(1);
+        return UART_Received;
+    }
+
+    /**
+     * @brief Blocking receive of one character (mirror of uart_getchar()).
+     *
+     * @param[out] status UART_Received, UART_Fault or UART_Empty on timeout.
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return Received character.
+     */
+    char Peer::getchar(UART_Data &status, int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        char data = 0;
+
+        while ((status = scanchar(data)) == UART_Empty)
+        {
+            int left = remaining(deadline, timeout_ms);
+
+            if (!left || !wait(EPOLLIN, left))
+            {
+                if (timeout_ms >= 0)
+                {
+                    return 0;
+                }
+            }
+        }
+        return data;
+    }
+
+    /**
+     * @brief Transmit one character (mirror of uart_putchar()).
+     *
+     * @return true if the character has been handed to the device.
+     */
+    bool Peer::putchar(char data, int timeout_ms)
+    {
+        return write(&data, 1, timeout_ms);
+    }
+
+    /**
+     * @brief Transmit a block of bytes.
+     *
+     * @param data Bytes to transmit.
+     * @param length Number of bytes.
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return true if all bytes have been handed to the device.
+     *
+     * @details
+     * Honors XOFF of the remote (UART_HANDSHAKE == 1), RTS/CTS is handled by the device driver. Data received while waiting is moved into the frame buffer, so an echoing remote cannot dead-lock the transfer.
+     */
+    bool Peer::write(const void *data, std::size_t length, int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        const std::uint8_t *position = static_cast<const std::uint8_t *>(data);
+
+        while (length)
+        {
+            if (config_.handshake == 1 && remote_ == UART_Pause)
+            {
+                int left = remaining(deadline, timeout_ms);
+
+                if (!left || !poll(left))
+                {
+                    if (timeout_ms >= 0 && !remaining(deadline, timeout_ms))
+                    {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            ssize_t result = ::write(fd_, position, length);
+
+            if (result > 0)
+            {
+                position += result;
+                length -= static_cast<std::size_t>(result);
+                continue;
+            }
+
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                throw system_error("write");
+            }
+
+            int left = remaining(deadline, timeout_ms);
+
+            if (!left)
+            {
+                return false;
+            }
+
+            poll(0);
+            wait(EPOLLOUT, left);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wait until all bytes have been transmitted (mirror of uart_flush()).
+     */
+    void Peer::flush()
+    {
+        ::tcdrain(fd_);
+    }
+
+    /**
+     * @brief Read and clear the latched receive error (mirror of uart_error_flags()).
+     */
+    UART_Error Peer::error_flags()
+    {
+        counters();
+
+        UART_Error error = error_;
+        error_ = UART_None;
+        return error;
+    }
+
+    /**
+     * @brief Manage flow control signaling (mirror of uart_handshake()).
+     *
+     * @param status UART_Ready, UART_Pause or UART_Status.
+     * @return Remote state for UART_Status, otherwise UART_Status.
+     */
+    UART_Handshake Peer::handshake(UART_Handshake status)
+    {
+        int rts = TIOCM_RTS;
+
+        if (status == UART_Ready)
+        {
+            if (config_.handshake == 1)
+            {
+                putchar(static_cast<char>(config_.xon));
+            }
+            else if (config_.handshake == 2)
+            {
+                ::ioctl(fd_, TIOCMBIS, &rts);
+            }
+        }
+        else if (status == UART_Pause)
+        {
+            if (config_.handshake == 1)
+            {
+                putchar(static_cast<char>(config_.xoff));
+            }
+            else if (config_.handshake == 2)
+            {
+                ::ioctl(fd_, TIOCMBIC, &rts);
+            }
+        }
+        else
+        {
+            if (config_.handshake == 1)
+            {
+                return remote_;
+            }
+            else if (config_.handshake == 2)
+            {
+                int lines = 0;
+
+                ::ioctl(fd_, TIOCMGET, &lines);
+                return (lines & TIOCM_CTS) ? UART_Ready : UART_Pause;
+            }
+        }
+        return UART_Status;
+    }
+
+    /**
+     * @brief View of all received and unread bytes (zero-copy).
+     */
+    View Peer::view() const
+    {
+        return rx_.view();
+    }
+
+    /**
+     * @brief Release bytes returned by view() or message().
+     */
+    void Peer::consume(std::size_t length)
+    {
+        rx_.consume(length);
+    }
+
+    /**
+     * @brief Take the next complete message out of the frame buffer.
+     *
+     * @param[out] message View of the message including the delimiter.
+     * @param delimiter Message delimiter (see UART_RX_MESSAGE_DELIMITER).
+     * @return true if a complete message is available.
+     *
+     * @note The message is consumed, the view stays valid until the next poll().
+     */
+    bool Peer::message(View &message, char delimiter)
+    {
+        View pending = rx_.view();
+        const void *end = std::memchr(pending.data, delimiter, pending.size);
+
+        if (!end)
+        {
+            return false;
+        }
+
+        message.data = pending.data;
+        message.size = static_cast<std::size_t>(static_cast<const std::uint8_t *>(end) - pending.data) + 1;
+        rx_.consume(message.size);
+        return true;
+    }
+
+    /**
+     * @brief Send a payload as frame (mirror of uart_frame_write()).
+     *
+     * @param data Payload bytes.
+     * @param length Payload length (frame_length_bytes 1: up to 255).
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return true if the frame has been handed to the device.
+     *
+     * @throws std::invalid_argument if the length cannot be encoded.
+     */
+    bool Peer::write_frame(const void *data, std::size_t length, int timeout_ms)
+    {
+        std::size_t limit = (config_.frame_length_bytes == 2) ? 0xFFFF : 0xFF;
+
+        if (length > limit)
+        {
+            throw std::invalid_argument("frame too long");
+        }
+
+        std::vector<std::uint8_t> frame;
+        frame.reserve(length + 4);
+
+        if (config_.frame_length_bytes == 2)
+        {
+            frame.push_back(static_cast<std::uint8_t>(length >> 8));
+        }
+        frame.push_back(static_cast<std::uint8_t>(length));
+
+        const std::uint8_t *payload = static_cast<const std::uint8_t *>(data);
+        frame.insert(frame.end(), payload, payload + length);
+
+        if (config_.frame_crc)
+        {
+            std::uint16_t crc = crc_xmodem(0, frame.data(), frame.size());
+
+            frame.push_back(static_cast<std::uint8_t>(crc >> 8));
+            frame.push_back(static_cast<std::uint8_t>(crc));
+        }
+        return write(frame.data(), frame.size(), timeout_ms);
+    }
+
+    /**
+     * @brief Take the next complete frame out of the frame buffer (mirror of uart_frame_read()).
+     *
+     * @param[out] payload View of the payload without length prefix and CRC.
+     * @return true if a complete and valid frame is available.
+     *
+     * @details
+     * On a CRC mismatch the first byte is dropped and the search restarts at the next byte, so the receiver finds the next length prefix after a corrupted one. A length prefix above Config::frame_max or a frame that never fits into the frame buffer is dropped the same way without waiting for its bytes. Dropped frames are counted (see frame_rejected()).
+     *
+     * @note The frame is consumed, the view stays valid until the next poll().
+     */
+    bool Peer::frame(View &payload)
+    {
+        std::size_t header = (config_.frame_length_bytes == 2) ? 2 : 1;
+        std::size_t trailer = config_.frame_crc ? 2 : 0;
+
+        for (;;)
+        {
+            View pending = rx_.view();
+
+            if (pending.size < header)
+            {
+                return false;
+            }
+
+            std::size_t length = (header == 2) ? ((static_cast<std::size_t>(pending.data[0]) << 8) | pending.data[1]) : pending.data[0];
+
+            // Corrupted length prefix, waiting for the frame would stall the receiver forever
+            if ((config_.frame_max && length > config_.frame_max) || header + length + trailer > config_.buffer_size)
+            {
+                frame_rejected_++;
+                rx_.consume(1);
+                continue;
+            }
+
+            if (pending.size < header + length + trailer)
+            {
+                return false;
+            }
+
+            if (config_.frame_crc && crc_xmodem(0, pending.data, header + length + trailer))
+            {
+                frame_rejected_++;
+                rx_.consume(1);
+                continue;
+            }
+
+            payload.data = pending.data + header;
+            payload.size = length;
+            rx_.consume(header + length + trailer);
+            return true;
+        }
+    }
+
+    /**
+     * @brief Read and reset the number of dropped frames (mirror of uart_frame_rejected()).
+     */
+    unsigned long Peer::frame_rejected()
+    {
+        unsigned long count = frame_rejected_;
+        frame_rejected_ = 0;
+        return count;
+    }
+
+    /**
+     * @brief File descriptor of the device (e.g. for an external event loop).
+     */
+    int Peer::fd() const
+    {
+        return fd_;
+    }
+
+    /**
+     * @brief Active line configuration.
+     */
+    const Config &Peer::config() const
+    {
+        return config_;
+    }
+}
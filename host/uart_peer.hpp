@@ -0,0 +1,171 @@
+/**
+ * @file uart_peer.hpp
+ * @brief Header file with declarations of the Linux host counterpart of the AVR UART driver.
+ *
+ * This file provides a serial peer for Linux build/test hosts that speaks the same frame format, flow control and error semantics (UART_Data, UART_Error, UART_Handshake) as uart.c. Received data is read directly into a frame buffer and handed out as views, so the application consumes it without further copies.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_PEER_HPP_
+#define UART_PEER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uart
+{
+    /**
+     * @brief Receive status, same meaning as UART_Data of the AVR driver.
+     */
+    enum UART_Data
+    {
+        UART_Empty = 0,     /**< No data available */
+        UART_Received,      /**< Data has been received */
+        UART_Fault          /**< Receive error occurred, see Peer::error_flags() */
+    };
+
+    /**
+     * @brief Receive error, same meaning as UART_Error of the AVR driver.
+     */
+    enum UART_Error
+    {
+        UART_None = 0,      /**< No error */
+        UART_Frame,         /**< Frame error (or break) */
+        UART_Overrun,       /**< Data overrun */
+        UART_Parity         /**< Parity error */
+    };
+
+    /**
+     * @brief Flow control command/state, same meaning as UART_Handshake of the AVR driver.
+     */
+    enum UART_Handshake
+    {
+        UART_Ready = 0,     /**< Ready to receive (XON/RTS asserted) */
+        UART_Pause,         /**< Not ready to receive (XOFF/RTS deasserted) */
+        UART_Status         /**< Query remote state */
+    };
+
+    /**
+     * @brief Line configuration, mirrors the uart.h configuration macros.
+     */
+    struct Config
+    {
+        unsigned long baudrate = 9600;      /**< UART_BAUDRATE */
+        unsigned char datasize = 8;         /**< UART_DATASIZE (5-8) */
+        unsigned char parity = 0;           /**< UART_PARITY (0 = none, 1 = even, 2 = odd) */
+        unsigned char stopbits = 1;         /**< UART_STOPBITS (1-2) */
+        unsigned char handshake = 0;        /**< UART_HANDSHAKE (0 = none, 1 = XON/XOFF, 2 = RTS/CTS) */
+        unsigned char xon = 0x11;           /**< UART_HANDSHAKE_XON */
+        unsigned char xoff = 0x13;          /**< UART_HANDSHAKE_XOFF */
+        unsigned char frame_length_bytes = 1;   /**< UART_FRAME_LENGTH_BYTES (1-2) */
+        bool frame_crc = true;              /**< UART_FRAME_CRC */
+        std::size_t frame_max = 0;          /**< Largest payload the firmware sends, 0 = limited by buffer_size only */
+        std::size_t buffer_size = 4096;     /**< Size of the receive frame buffer in bytes */
+    };
+
+    /**
+     * @brief Read-only view into the receive frame buffer.
+     *
+     * @note A view is valid until the next call of Peer::poll(), Peer::consume() or any receive function.
+     */
+    struct View
+    {
+        const std::uint8_t *data = nullptr;
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Linear receive buffer that is filled in place by read() and consumed through views.
+     *
+     * @details
+     * Unread data is moved to the front only when the free tail gets too small for the next read, so in steady state every byte is copied exactly once (kernel to buffer).
+     */
+    class FrameBuffer
+    {
+    public:
+        explicit FrameBuffer(std::size_t size);
+
+        std::uint8_t *space(std::size_t &length);
+        void produced(std::size_t length);
+
+        View view() const;
+        void consume(std::size_t length);
+        std::size_t size() const;
+
+    private:
+        std::vector<std::uint8_t> buffer_;
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+    };
+
+    /**
+     * @brief Linux serial peer of the AVR UART driver (termios/epoll).
+     *
+     * @details
+     * The function set mirrors uart.c: scanchar()/getchar()/putchar()/write()/flush()/error_flags()/handshake() and the frame functions write_frame()/frame() (UART_FRAME). Errors of the line discipline are reported through PARMRK marks and the serial icounters (if the device supports TIOCGICOUNT), the faulty byte is discarded and the next scanchar() returns UART_Fault, same as the AVR receive queue.
+     *
+     * @note Errors during open and configuration are thrown as std::system_error or std::invalid_argument.
+     */
+    class Peer
+    {
+    public:
+        explicit Peer(const std::string &path, const Config &config = Config());
+        ~Peer();
+
+        Peer(const Peer &) = delete;
+        Peer &operator=(const Peer &) = delete;
+
+        UART_Data scanchar(char &data);
+        char getchar(UART_Data &status, int timeout_ms = -1);
+        bool putchar(char data, int timeout_ms = -1);
+        bool write(const void *data, std::size_t length, int timeout_ms = -1);
+        void flush();
+        UART_Error error_flags();
+        UART_Handshake handshake(UART_Handshake status);
+
+        std::size_t poll(int timeout_ms);
+        View view() const;
+        void consume(std::size_t length);
+        bool message(View &message, char delimiter = '\n');
+
+        bool write_frame(const void *data, std::size_t length, int timeout_ms = -1);
+        bool frame(View &payload);
+        unsigned long frame_rejected();
+
+        int fd() const;
+        const Config &config() const;
+
+    private:
+        void configure();
+        bool wait(std::uint32_t events, int timeout_ms);
+        void decode(std::uint8_t *data, std::size_t length);
+        void counters();
+
+        Config config_;
+        FrameBuffer rx_;
+        int fd_ = -1;
+        int epoll_ = -1;
+        UART_Error error_ = UART_None;
+        UART_Handshake remote_ = UART_Ready;
+        unsigned char mark_ = 0;            // PARMRK decoder state
+        bool icount_ = false;
+        unsigned long frame_count_ = 0;
+        unsigned long overrun_count_ = 0;
+        unsigned long parity_count_ = 0;
+        unsigned long frame_rejected_ = 0;
+    };
+}
+
+#endif /* UART_PEER_HPP_ */
@@ -0,0 +1,259 @@
+/**
+ * @file uart_rpc.cpp
+ * @brief Source file with implementation of the host side of the UART RPC layer.
+ *
+ * This file contains request batching and response matching of the RPC client. The message layout is the one of uart_rpc.h: ID, method/status and length (1 byte each) followed by arguments/result.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_rpc.hpp for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_rpc.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace uart
+{
+    namespace
+    {
+        const std::size_t header = 3;
+    }
+
+    /**
+     * @brief Create a client on an open peer.
+     *
+     * @param peer Peer with the frame configuration of the firmware.
+     * @param max_frame Largest request frame payload the firmware accepts (UART_FRAME_RX_MAX).
+     *
+     * @throws std::invalid_argument if max_frame cannot hold a request header.
+     */
+    RpcClient::RpcClient(Peer &peer, std::size_t max_frame)
+        : peer_(peer), max_frame_(max_frame)
+    {
+        if (max_frame_ < header)
+        {
+            throw std::invalid_argument("max_frame too small");
+        }
+    }
+
+    /**
+     * @brief Queue a request for the next send().
+     *
+     * @param method Method number (index in the method table of the firmware).
+     * @param args Argument bytes.
+     * @param length Number of argument bytes (max 255).
+     * @return Request ID, -1 if 256 requests are outstanding.
+     *
+     * @throws std::invalid_argument if the request does not fit into a frame.
+     */
+    int RpcClient::call(std::uint8_t method, const void *args, std::size_t length)
+    {
+        if (length > 255 || header + length > max_frame_)
+        {
+            throw std::invalid_argument("request too long");
+        }
+
+        if (outstanding_ == capacity_)
+        {
+            return -1;
+        }
+
+        while (pending_[next_] || reserved_[next_])
+        {
+            next_++;
+        }
+
+        std::uint8_t id = next_++;
+        std::size_t start = splits_.empty() ? 0 : splits_.back();
+
+        if (splits_.empty() || batch_.size() - start + header + length > max_frame_)
+        {
+            splits_.push_back(batch_.size());
+        }
+
+        const std::uint8_t *bytes = static_cast<const std::uint8_t *>(args);
+
+        batch_.push_back(id);
+        batch_.push_back(method);
+        batch_.push_back(static_cast<std::uint8_t>(length));
+        batch_.insert(batch_.end(), bytes, bytes + length);
+
+        pending_[id] = true;
+        outstanding_++;
+        return id;
+    }
+
+    /**
+     * @brief Send all queued requests.
+     *
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return true if all frames have been handed to the device.
+     */
+    bool RpcClient::send(int timeout_ms)
+    {
+        bool result = true;
+
+        for (std::size_t i = 0; i < splits_.size() && result; i++)
+        {
+            std::size_t end = (i + 1 < splits_.size()) ? splits_[i + 1] : batch_.size();
+
+            result = peer_.write_frame(batch_.data() + splits_[i], end - splits_[i], timeout_ms);
+        }
+
+        batch_.clear();
+        splits_.clear();
+        return result;
+    }
+
+    /**
+     * @brief Take the next response, in arrival order.
+     *
+     * @param[out] response Response of one of the outstanding requests.
+     * @param timeout_ms Timeout in milliseconds (-1 = infinite).
+     * @return true if a response is available.
+     */
+    bool RpcClient::response(Response &response, int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        for (;;)
+        {
+            receive();
+
+            if (!responses_.empty())
+            {
+                response = std::move(responses_.front());
+                responses_.pop_front();
+                return true;
+            }
+
+            int left = timeout_ms;
+
+            if (timeout_ms >= 0)
+            {
+                auto now = std::chrono::steady_clock::now();
+
+                if (now >= deadline)
+                {
+                    return false;
+                }
+                left = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1;
+            }
+
+            peer_.poll(left);
+        }
+    }
+
+    /**
+     * @brief Reserve an ID for unsolicited messages of the firmware.
+     *
+     * @param id Message ID, it must not be used by an outstanding request.
+     *
+     * @throws std::logic_error if a request with this ID is outstanding.
+     */
+    void RpcClient::reserve(std::uint8_t id)
+    {
+        if (pending_[id])
+        {
+            throw std::logic_error("id in use");
+        }
+
+        if (!reserved_[id])
+        {
+            reserved_[id] = true;
+            capacity_--;
+        }
+    }
+
+    /**
+     * @brief Take the next unsolicited message, in arrival order.
+     *
+     * @param[out] message Message with a reserved ID, its status and payload.
+     * @return true if a message is available.
+     *
+     * @details
+     * Does not wait, unsolicited messages are collected while response() waits or by calling it with timeout 0.
+     */
+    bool RpcClient::unsolicited(Response &message)
+    {
+        receive();
+
+        if (unsolicited_.empty())
+        {
+            return false;
+        }
+
+        message = std::move(unsolicited_.front());
+        unsolicited_.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief Number of requests without response.
+     */
+    std::size_t RpcClient::outstanding() const
+    {
+        return outstanding_;
+    }
+
+    /**
+     * @brief Peer of the client, e.g. for its frame configuration.
+     */
+    const Peer &RpcClient::peer() const
+    {
+        return peer_;
+    }
+
+    /**
+     * @brief Split received frames into responses and unsolicited messages, unknown IDs are ignored.
+     */
+    void RpcClient::receive()
+    {
+        View payload;
+
+        while (peer_.frame(payload))
+        {
+            const std::uint8_t *message = payload.data;
+            std::size_t length = payload.size;
+
+            while (length >= header && header + message[2] <= length)
+            {
+                std::uint8_t id = message[0];
+
+                if (pending_[id] || reserved_[id])
+                {
+                    Response response;
+
+                    response.id = id;
+                    response.status = message[1];
+                    response.result.assign(message + header, message + header + message[2]);
+
+                    if (reserved_[id])
+                    {
+                        unsolicited_.push_back(std::move(response));
+                    }
+                    else
+                    {
+                        responses_.push_back(std::move(response));
+
+                        pending_[id] = false;
+                        outstanding_--;
+                    }
+                }
+
+                length -= header + message[2];
+                message += header + message[2];
+            }
+        }
+    }
+}
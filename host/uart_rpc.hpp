@@ -0,0 +1,93 @@
+/**
+ * @file uart_rpc.hpp
+ * @brief Header file with declarations of the host side of the UART RPC layer.
+ *
+ * This file provides the client of uart_rpc.c. Requests are collected into a batch and sent as one frame, responses are matched by ID in the order they arrive, so many requests can be outstanding at the same time.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_RPC_HPP_
+#define UART_RPC_HPP_
+
+#include "uart_peer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace uart
+{
+    /**
+     * @brief Response status, same values as UART_RPC_OK/UART_RPC_ERROR/... of uart_rpc.h.
+     */
+    enum UART_RPC_Status
+    {
+        UART_RPC_OK = 0,        /**< Method completed */
+        UART_RPC_ERROR,         /**< Method failed */
+        UART_RPC_UNKNOWN,       /**< Method number not in the method table */
+        UART_RPC_MALFORMED      /**< Argument length exceeds the frame */
+    };
+
+    /**
+     * @brief Response of a request.
+     */
+    struct Response
+    {
+        std::uint8_t id = 0;
+        std::uint8_t status = UART_RPC_OK;
+        std::vector<std::uint8_t> result;
+    };
+
+    /**
+     * @brief RPC client on top of the frame functions of a uart::Peer.
+     *
+     * @details
+     * call() only queues a request, send() writes all queued requests as one frame (split into several frames if they exceed max_frame, the UART_FRAME_RX_MAX of the firmware). IDs of outstanding requests are never reused, up to 256 requests can be in flight.
+     *
+     * IDs passed to reserve() are never assigned to requests. Messages with a reserved ID (e.g. UART_TELEMETRY_ID of uart_telemetry.h) are unsolicited and collected for unsolicited().
+     */
+    class RpcClient
+    {
+    public:
+        RpcClient(Peer &peer, std::size_t max_frame);
+
+        int call(std::uint8_t method, const void *args = nullptr, std::size_t length = 0);
+        bool send(int timeout_ms = -1);
+        bool response(Response &response, int timeout_ms = -1);
+
+        void reserve(std::uint8_t id);
+        bool unsolicited(Response &message);
+
+        std::size_t outstanding() const;
+        const Peer &peer() const;
+
+    private:
+        void receive();
+
+        Peer &peer_;
+        std::size_t max_frame_;
+        std::vector<std::uint8_t> batch_;
+        std::vector<std::size_t> splits_;       // Batch offsets where a new frame starts
+        std::deque<Response> responses_;
+        std::deque<Response> unsolicited_;
+        std::array<bool, 256> pending_{};
+        std::array<bool, 256> reserved_{};
+        std::size_t outstanding_ = 0;
+        std::size_t capacity_ = 256;            // IDs that are not reserved
+        std::uint8_t next_ = 0;
+    };
+}
+
+#endif /* UART_RPC_HPP_ */
@@ -0,0 +1,47 @@
+/**
+ * @file FreeRTOSConfig.h
+ * @brief FreeRTOS configuration of the UART_RTOS build check.
+ *
+ * This file provides the kernel options uart.c requires with UART_RTOS > 0 (see @ref UART_RTOS), all other options are minimal. It is only used to compile the driver, not to run the kernel.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+    #define configUSE_PREEMPTION                1
+    #define configUSE_IDLE_HOOK                 0
+    #define configUSE_TICK_HOOK                 0
+    #define configCPU_CLOCK_HZ                  (F_CPU)
+    #define configTICK_RATE_HZ                  ((TickType_t)1000)
+    #define configMAX_PRIORITIES                4
+    #define configMINIMAL_STACK_SIZE            ((unsigned short)85)
+    #define configTOTAL_HEAP_SIZE               ((size_t)1024)
+    #define configMAX_TASK_NAME_LEN             8
+    #define configTICK_TYPE_WIDTH_IN_BITS       TICK_TYPE_WIDTH_16_BITS
+    #define configIDLE_SHOULD_YIELD             1
+
+    #define configSUPPORT_DYNAMIC_ALLOCATION    1
+    #define configSUPPORT_STATIC_ALLOCATION     0
+
+    // Required by uart.c
+    #define configUSE_MUTEXES                   1
+    #define configUSE_RECURSIVE_MUTEXES         1
+    #define configUSE_COUNTING_SEMAPHORES       1
+
+    #define INCLUDE_xTaskGetSchedulerState      1
+    #define INCLUDE_xSemaphoreGetMutexHolder    1
+    #define INCLUDE_xTaskGetCurrentTaskHandle   1
+    #define INCLUDE_vTaskDelay                  1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,30 @@
+/**
+ * @file eeprom.h
+ * @brief Host stub of <avr/eeprom.h> for the host checks.
+ *
+ * The checks that use the EEPROM functions define them.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_AVR_EEPROM_H_
+#define STUB_AVR_EEPROM_H_
+
+    #include <stddef.h>
+    #include <stdint.h>
+
+    uint8_t eeprom_read_byte(const uint8_t *address);
+    void eeprom_update_byte(uint8_t *address, uint8_t value);
+    void eeprom_read_block(void *destination, const void *source, size_t length);
+    void eeprom_update_block(const void *source, void *destination, size_t length);
+
+#endif /* STUB_AVR_EEPROM_H_ */
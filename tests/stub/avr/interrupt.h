@@ -0,0 +1,29 @@
+/**
+ * @file interrupt.h
+ * @brief Host stub of <avr/interrupt.h> for the host checks.
+ *
+ * ISR() defines a plain function with the vector name, the checks call it directly.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_AVR_INTERRUPT_H_
+#define STUB_AVR_INTERRUPT_H_
+
+    #include <avr/io.h>
+
+    #define ISR(vector, ...) void vector(void); void vector(void)
+
+    #define cli() (SREG &= (uint8_t)~(1<<SREG_I))
+    #define sei() (SREG |= (1<<SREG_I))
+
+#endif /* STUB_AVR_INTERRUPT_H_ */
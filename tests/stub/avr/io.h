@@ -0,0 +1,71 @@
+/**
+ * @file io.h
+ * @brief Host stub of <avr/io.h> for the host checks.
+ *
+ * This file provides the USART registers of the ATmega16 as plain variables (see registers.c) and the bit numbers of avr-libc. The checks act as the hardware: they set RXC/UDR and call the ISR functions, and read UDR after each ISR call.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_AVR_IO_H_
+#define STUB_AVR_IO_H_
+
+    #include <stdint.h>
+
+    extern volatile uint8_t UCSRA, UCSRB, UCSRC, UBRRH, UBRRL, UDR, SREG, OSCCAL;
+    extern volatile uint8_t DDRD, PORTD, PIND, TCCR1A, TCCR1B, TIFR;
+    extern volatile uint16_t TCNT1;
+
+    // UCSRA
+    #define RXC 7
+    #define TXC 6
+    #define UDRE 5
+    #define FE 4
+    #define DOR 3
+    #define UPE 2
+    #define U2X 1
+    #define MPCM 0
+
+    // UCSRB
+    #define RXCIE 7
+    #define TXCIE 6
+    #define UDRIE 5
+    #define RXEN 4
+    #define TXEN 3
+    #define UCSZ2 2
+    #define RXB8 1
+    #define TXB8 0
+
+    // UCSRC
+    #define URSEL 7
+    #define UMSEL 6
+    #define UPM1 5
+    #define UPM0 4
+    #define USBS 3
+    #define UCSZ1 2
+    #define UCSZ0 1
+    #define UCPOL 0
+
+    #define PD0 0
+    #define PD1 1
+    #define PD2 2
+    #define PD4 4
+    #define PIND0 0
+    #define CS10 0
+    #define TOV1 2
+    #define SREG_I 7
+
+    #define RAMEND 0x45F
+    #define E2END 0x1FF
+    #define FLASHEND 0x3FFF
+
+#endif /* STUB_AVR_IO_H_ */
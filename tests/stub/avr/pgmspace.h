@@ -0,0 +1,38 @@
+/**
+ * @file pgmspace.h
+ * @brief Host stub of <avr/pgmspace.h> for the host checks.
+ *
+ * Flash memory is ordinary memory on the host, the _P functions map to their RAM counterparts.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_AVR_PGMSPACE_H_
+#define STUB_AVR_PGMSPACE_H_
+
+    #include <stdint.h>
+    #include <string.h>
+
+    #define PROGMEM
+    #define PSTR(s) (s)
+    #define PGM_P const char *
+    #define PGM_VOID_P const void *
+
+    #define pgm_read_byte(address) (*(const uint8_t *)(address))
+    #define pgm_read_word(address) (*(const uint16_t *)(address))
+    #define pgm_read_dword(address) (*(const uint32_t *)(address))
+    #define pgm_read_ptr(address) (*(void * const *)(address))
+
+    #define memcpy_P memcpy
+    #define strlen_P strlen
+
+#endif /* STUB_AVR_PGMSPACE_H_ */
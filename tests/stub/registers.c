@@ -0,0 +1,23 @@
+/**
+ * @file registers.c
+ * @brief Registers of the host stub of <avr/io.h>.
+ *
+ * The transmitter is always ready (UDRE, TXC) and interrupts are enabled.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <avr/io.h>
+
+volatile uint8_t UCSRA = (1<<UDRE) | (1<<TXC), UCSRB, UCSRC, UBRRH, UBRRL, UDR, SREG = (1<<SREG_I), OSCCAL;
+volatile uint8_t DDRD, PORTD, PIND, TCCR1A, TCCR1B, TIFR;
+volatile uint16_t TCNT1;
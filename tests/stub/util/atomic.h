@@ -0,0 +1,29 @@
+/**
+ * @file atomic.h
+ * @brief Host stub of <util/atomic.h> for the host checks.
+ *
+ * The checks are single-threaded and call the ISR functions themselves, so the blocks only have to run once.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_UTIL_ATOMIC_H_
+#define STUB_UTIL_ATOMIC_H_
+
+    #define ATOMIC_RESTORESTATE
+    #define ATOMIC_FORCEON
+    #define NONATOMIC_RESTORESTATE
+
+    #define ATOMIC_BLOCK(type) for (int atomic_once = 1; atomic_once; atomic_once = 0)
+    #define NONATOMIC_BLOCK(type) for (int nonatomic_once = 1; nonatomic_once; nonatomic_once = 0)
+
+#endif /* STUB_UTIL_ATOMIC_H_ */
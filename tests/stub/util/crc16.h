@@ -0,0 +1,42 @@
+/**
+ * @file crc16.h
+ * @brief Host stub of <util/crc16.h> for the host checks.
+ *
+ * _crc_xmodem_update() is the C equivalent given in the avr-libc documentation of the inline assembler version.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_UTIL_CRC16_H_
+#define STUB_UTIL_CRC16_H_
+
+    #include <stdint.h>
+
+    static inline uint16_t _crc_xmodem_update(uint16_t crc, uint8_t data)
+    {
+        crc = crc ^ ((uint16_t)data << 8);
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            if (crc & 0x8000)
+            {
+                crc = (crc << 1) ^ 0x1021;
+            }
+            else
+            {
+                crc <<= 1;
+            }
+        }
+        return crc;
+    }
+
+#endif /* STUB_UTIL_CRC16_H_ */
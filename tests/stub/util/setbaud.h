@@ -0,0 +1,27 @@
+/**
+ * @file setbaud.h
+ * @brief Host stub of <util/setbaud.h> for the host checks.
+ *
+ * Fixed values for the default configuration (12 MHz, 9600 baud).
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef STUB_UTIL_SETBAUD_H_
+#define STUB_UTIL_SETBAUD_H_
+
+    #define UBRR_VALUE 77
+    #define UBRRL_VALUE 77
+    #define UBRRH_VALUE 0
+    #define USE_2X 0
+
+#endif /* STUB_UTIL_SETBAUD_H_ */
@@ -0,0 +1,199 @@
+/**
+ * @file uart_frame_test.c
+ * @brief Host check of CRC-16/XMODEM, frame transmission and the frame receive parser.
+ *
+ * Frames sent with uart_frame_write() are fed back into ISR(UART_RXC_vect), so the check covers the frame layout of both directions and the resynchronisation of the parser after faulty frames.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <string.h>
+#include <util/crc16.h>
+
+#include "uart.h"
+#include "uart_test.h"
+
+#if UART_FRAME_RX == 0 || UART_FRAME_CRC == 0 || UART_FRAME_LENGTH_BYTES != 1 || UART_TX_BUFFER_SIZE == 0
+    #error "uart_frame_test requires UART_FRAME_RX, UART_FRAME_CRC, UART_FRAME_LENGTH_BYTES 1 and a transmit queue"
+#endif
+
+static uint16_t crc(const uint8_t *data, uint16_t length)
+{
+    uint16_t value = 0;
+
+    while (length--)
+    {
+        value = _crc_xmodem_update(value, *data++);
+    }
+    return value;
+}
+
+/**
+ * @brief Build a frame with length prefix and big-endian CRC.
+ */
+static uint16_t frame(uint8_t *out, const void *payload, uint8_t length)
+{
+    out[0] = length;
+    memcpy(&out[1], payload, length);
+
+    uint16_t value = crc(out, length + 1);
+
+    out[length + 1] = (uint8_t)(value >> 8);
+    out[length + 2] = (uint8_t)value;
+    return length + UART_FRAME_OVERHEAD;
+}
+
+static void check_crc(void)
+{
+    // Check value of CRC-16/XMODEM
+    UART_CHECK(crc((const uint8_t *)"123456789", 9) == 0x31C3);
+
+    // CRC over data and its own big-endian CRC is 0, the receive parser relies on it
+    uint8_t data[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9', 0x31, 0xC3 };
+    UART_CHECK(crc(data, sizeof(data)) == 0);
+}
+
+static void check_transmit(void)
+{
+    uint8_t sent[80];
+    uint8_t expected[80];
+    uint16_t count;
+
+    UART_CHECK(uart_frame_write("123456789", 9) == 0);
+    count = uart_test_transmit(sent, sizeof(sent));
+
+    UART_CHECK(count == 12);
+    UART_CHECK(sent[0] == 9);
+    UART_CHECK(!memcmp(&sent[1], "123456789", 9));
+    UART_CHECK(sent[10] == 0x14 && sent[11] == 0xCD);
+
+    // Frame streamed in parts
+    UART_CHECK(uart_frame_begin(5) == 0);
+    uart_frame_put("ab", 2);
+    uart_frame_put("cde", 3);
+    UART_CHECK(uart_frame_end() == 0);
+    count = uart_test_transmit(sent, sizeof(sent));
+
+    UART_CHECK(count == frame(expected, "abcde", 5));
+    UART_CHECK(!memcmp(sent, expected, count));
+
+    // Empty frame
+    UART_CHECK(uart_frame_write("", 0) == 0);
+    count = uart_test_transmit(sent, sizeof(sent));
+
+    UART_CHECK(count == frame(expected, "", 0));
+    UART_CHECK(!memcmp(sent, expected, count));
+}
+
+static void check_direct(void)
+{
+    uint8_t payload[UART_TX_BUFFER_SIZE + 8];
+
+    memset(payload, 'p', sizeof(payload));
+
+    // Larger than the transmit queue, interrupts disabled so the writer drains the queue by polling
+    SREG &= (uint8_t)~(1<<SREG_I);
+    uart_tx_discarded();
+
+    UART_CHECK(uart_frame_begin(sizeof(payload)) == 0);
+    uart_frame_put(payload, 10);
+
+    // Another producer (e.g. an ISR) must not end up inside the frame
+    UART_CHECK(uart_putchar('x') == 1);
+    UART_CHECK(uart_write("xyz", 3) == 1);
+    UART_CHECK(uart_tx_discarded() == 4);
+
+    uart_frame_put(&payload[10], sizeof(payload) - 10);
+    UART_CHECK(uart_frame_end() == 0);
+
+    UART_CHECK(uart_putchar('y') == 0);
+    UART_CHECK(uart_tx_discarded() == 0);
+
+    SREG |= (1<<SREG_I);
+
+    // Empty the queue, the receive echo of the next check must not block
+    uart_test_transmit(payload, sizeof(payload));
+}
+
+static void check_receive(void)
+{
+    uint8_t sent[80];
+    uint8_t data[80];
+    uint16_t count;
+    uint16_t length;
+
+    // Loopback of a transmitted frame
+    UART_CHECK(uart_frame_write("hello", 5) == 0);
+    count = uart_test_transmit(sent, sizeof(sent));
+
+    uart_test_receive(sent, 3, -1);
+    UART_CHECK(uart_frame_available() == 0);
+    uart_test_receive(&sent[3], count - 3, -1);
+    UART_CHECK(uart_frame_available() == 1);
+
+    UART_CHECK(uart_frame_read(data, sizeof(data), &length) == UART_Received);
+    UART_CHECK(length == 5 && !memcmp(data, "hello", 5));
+    UART_CHECK(uart_frame_read(data, sizeof(data), &length) == UART_Empty);
+
+    // Back-to-back frames
+    count = frame(sent, "one", 3);
+    count += frame(&sent[count], "three", 5);
+    uart_test_receive(sent, count, -1);
+
+    UART_CHECK(uart_frame_available() == 2);
+    UART_CHECK(uart_frame_read(data, sizeof(data), &length) == UART_Received && length == 3 && !memcmp(data, "one", 3));
+    UART_CHECK(uart_frame_read(data, sizeof(data), &length) == UART_Received && length == 5 && !memcmp(data, "three", 5));
+    UART_CHECK(uart_frame_rejected() == 0);
+
+    // CRC mismatch
+    count = frame(sent, "abc", 3);
+    sent[2] ^= 0x01;
+    uart_test_receive(sent, count, -1);
+
+    UART_CHECK(uart_frame_available() == 0);
+    UART_CHECK(uart_frame_rejected() == 1);
+
+    // Receive error inside a frame with a valid CRC
+    count = frame(sent, "abc", 3);
+    uart_test_receive(sent, count, 2);
+
+    UART_CHECK(uart_frame_available() == 0);
+    UART_CHECK(uart_frame_rejected() == 1);
+
+    // Frame too long for the receive queue, the parser skips it and stays in sync
+    memset(data, 'x', sizeof(data));
+    count = frame(sent, data, UART_FRAME_RX_MAX + 1);
+    count += frame(&sent[count], "ok", 2);
+    uart_test_receive(sent, count, -1);
+
+    UART_CHECK(uart_frame_rejected() == 1);
+    UART_CHECK(uart_frame_read(data, sizeof(data), &length) == UART_Received && length == 2 && !memcmp(data, "ok", 2));
+
+    // Payload larger than the buffer of the reader
+    count = frame(sent, "truncated", 9);
+    uart_test_receive(sent, count, -1);
+
+    UART_CHECK(uart_frame_read(data, 4, &length) == UART_Fault && length == 9 && !memcmp(data, "trun", 4));
+    UART_CHECK(uart_frame_available() == 0);
+}
+
+int main(void)
+{
+    uart_init();
+
+    check_crc();
+    check_transmit();
+    check_direct();
+    check_receive();
+
+    return UART_TEST_RESULT();
+}
@@ -0,0 +1,90 @@
+/**
+ * @file uart_handshake_test.c
+ * @brief Host check of the XON/XOFF handshake of the transmit and receive queues.
+ *
+ * The local XON/XOFF has to leave ahead of the queued bytes, a remote XOFF has to stop the transmit queue until XON.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <string.h>
+
+#include "uart.h"
+#include "uart_test.h"
+
+#if UART_HANDSHAKE != 1 || UART_TX_BUFFER_SIZE == 0 || UART_RX_BUFFER_SIZE == 0
+    #error "uart_handshake_test requires UART_HANDSHAKE 1 and both queues"
+#endif
+
+static void check_local(void)
+{
+    uint8_t sent[80];
+    uint8_t fill[UART_RX_HANDSHAKE_HIGH];
+    uint16_t count;
+    char data;
+
+    memset(fill, 'r', sizeof(fill));
+    UART_CHECK(uart_write("queued", 6) == 0);
+
+    // UDR empty, XOFF is written directly (the stub shares UDR between receiver and transmitter)
+    uart_test_receive(fill, sizeof(fill) - 1, -1);
+    UART_CHECK(UDR == 'r');
+    uart_test_receive(fill, 1, -1);
+    UART_CHECK(UDR == UART_HANDSHAKE_XOFF);
+
+    count = uart_test_transmit(sent, sizeof(sent));
+    UART_CHECK(count == 6 && !memcmp(sent, "queued", 6));
+
+    // UDR full, XON waits in front of the queue
+    UART_CHECK(uart_write("abc", 3) == 0);
+    UCSRA &= ~(1<<UDRE);
+
+    while (uart_scanchar(&data) == UART_Received);
+
+    UCSRA |= (1<<UDRE);
+    count = uart_test_transmit(sent, sizeof(sent));
+    UART_CHECK(count == 4);
+    UART_CHECK(sent[0] == UART_HANDSHAKE_XON && !memcmp(&sent[1], "abc", 3));
+}
+
+static void check_remote(void)
+{
+    uint8_t sent[80];
+    uint8_t xoff = UART_HANDSHAKE_XOFF;
+    uint8_t xon = UART_HANDSHAKE_XON;
+    uint16_t count;
+
+    uart_test_receive(&xoff, 1, -1);
+    UART_CHECK(uart_handshake(UART_Status) == UART_Pause);
+
+    // Queued data waits, UDRIE is off until XON
+    UART_CHECK(uart_write("xyz", 3) == 0);
+    UART_UDRE_vect();
+    UART_CHECK(!(UCSRB & (1<<UDRIE)));
+
+    uart_test_receive(&xon, 1, -1);
+    UART_CHECK(uart_handshake(UART_Status) == UART_Ready);
+    UART_CHECK(UCSRB & (1<<UDRIE));
+
+    count = uart_test_transmit(sent, sizeof(sent));
+    UART_CHECK(count == 3 && !memcmp(sent, "xyz", 3));
+}
+
+int main(void)
+{
+    uart_init();
+
+    check_local();
+    check_remote();
+
+    return UART_TEST_RESULT();
+}
@@ -0,0 +1,223 @@
+/**
+ * @file uart_memory_client_test.cpp
+ * @brief Host check of the request window of host/uart_memory.cpp.
+ *
+ * A thread plays the firmware behind a pseudo terminal: it reads the request frames into a receive queue of fixed size, answers one frame at a time with a delay (like EEPROM writes) and drops frames that do not fit into the queue, as uart.c does. Transfers much larger than the queue have to complete without a dropped request.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_memory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    int failed = 0;
+
+    #define UART_CHECK(condition) \
+        do { if (!(condition)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); failed++; } } while (0)
+
+    constexpr std::size_t header = 3;
+    constexpr std::size_t queue_size = 63;      // UART_RX_BUFFER_SIZE 64
+    constexpr std::size_t max_frame = 62;       // UART_FRAME_RX_MAX
+
+    std::uint16_t crc_xmodem(const std::uint8_t *data, std::size_t length)
+    {
+        std::uint16_t crc = 0;
+
+        while (length--)
+        {
+            crc ^= static_cast<std::uint16_t>(*data++ << 8);
+
+            for (int i = 0; i < 8; i++)
+            {
+                crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Firmware side: receive queue, EEPROM and the two memory methods.
+     */
+    struct Device
+    {
+        int master;
+        std::vector<std::uint8_t> eeprom = std::vector<std::uint8_t>(0x10000);
+        std::vector<std::uint8_t> queue;        // Frames in the receive queue, length prefix and CRC included
+        std::size_t dropped = 0;
+        std::size_t largest = 0;
+        std::atomic<bool> stop{ false };
+
+        void respond(const std::vector<std::uint8_t> &payload)
+        {
+            std::vector<std::uint8_t> frame(1, static_cast<std::uint8_t>(payload.size()));
+
+            frame.insert(frame.end(), payload.begin(), payload.end());
+
+            std::uint16_t crc = crc_xmodem(frame.data(), frame.size());
+
+            frame.push_back(static_cast<std::uint8_t>(crc >> 8));
+            frame.push_back(static_cast<std::uint8_t>(crc));
+            UART_CHECK(::write(master, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size()));
+        }
+
+        /**
+         * @brief Answer the requests of the oldest frame in the queue.
+         */
+        void process()
+        {
+            std::size_t length = queue[0];
+            std::size_t position = 1;
+
+            UART_CHECK(crc_xmodem(queue.data(), 1 + length + 2) == 0);
+
+            // One response frame per request, a read result fills a frame
+            while (position + header <= 1 + length)
+            {
+                const std::uint8_t *request = &queue[position];
+                std::uint16_t address = static_cast<std::uint16_t>(request[4] | (request[5] << 8));
+                std::vector<std::uint8_t> response;
+
+                response.push_back(request[0]);
+                response.push_back(uart::UART_RPC_OK);
+
+                if (request[1] == 0)
+                {
+                    response.push_back(request[6]);
+                    response.insert(response.end(), &eeprom[address], &eeprom[address] + request[6]);
+                }
+                else
+                {
+                    std::memcpy(&eeprom[address], &request[6], request[2] - 3);
+                    response.push_back(0);
+
+                    // EEPROM write time of the block
+                    std::this_thread::sleep_for(std::chrono::microseconds(100 * (request[2] - 3)));
+                }
+                respond(response);
+                position += header + request[2];
+            }
+            queue.erase(queue.begin(), queue.begin() + 1 + length + 2);
+        }
+
+        void run()
+        {
+            std::vector<std::uint8_t> line;
+            std::uint8_t buffer[256];
+            pollfd descriptor = { master, POLLIN, 0 };
+
+            while (!stop)
+            {
+                if (::poll(&descriptor, 1, 5) > 0)
+                {
+                    ssize_t count = ::read(master, buffer, sizeof(buffer));
+
+                    if (count > 0)
+                    {
+                        line.insert(line.end(), buffer, buffer + count);
+                    }
+                }
+
+                // Complete frames enter the queue if they fit
+                while (!line.empty() && line.size() >= 1 + line[0] + 2u)
+                {
+                    std::size_t size = 1 + line[0] + 2;
+
+                    if (queue.size() + size > queue_size)
+                    {
+                        dropped++;
+                    }
+                    else
+                    {
+                        queue.insert(queue.end(), line.begin(), line.begin() + size);
+                        largest = std::max(largest, queue.size());
+                    }
+                    line.erase(line.begin(), line.begin() + size);
+                }
+
+                if (!queue.empty())
+                {
+                    process();
+                }
+            }
+        }
+    };
+}
+
+int main()
+{
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0)
+    {
+        std::perror("posix_openpt");
+        return EXIT_FAILURE;
+    }
+
+    uart::Peer peer(::ptsname(master));
+    uart::RpcClient rpc(peer, max_frame);
+    uart::MemoryClient memory(rpc, 0, 1, max_frame, queue_size);
+    Device device;
+
+    device.master = master;
+
+    std::thread firmware(&Device::run, &device);
+    std::vector<std::uint8_t> data(1000);
+    std::vector<std::uint8_t> back(data.size());
+
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 13 + 1);
+    }
+
+    // Many times the receive queue in one transfer
+    UART_CHECK(memory.write(uart::UART_MEMORY_EEPROM, 0x0100, data.data(), data.size()));
+    UART_CHECK(!std::memcmp(&device.eeprom[0x0100], data.data(), data.size()));
+
+    UART_CHECK(memory.read(uart::UART_MEMORY_EEPROM, 0x0100, back.data(), back.size()));
+    UART_CHECK(back == data);
+
+    device.stop = true;
+    firmware.join();
+
+    UART_CHECK(device.dropped == 0);
+    UART_CHECK(device.largest <= queue_size);
+
+    // A window that cannot hold one byte of data
+    try
+    {
+        uart::MemoryClient small(rpc, 0, 1, max_frame, header + 3 + 3);
+        UART_CHECK(!"window without room for data accepted");
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+
+    ::close(master);
+
+    std::fprintf(stderr, "%s: %s\n", __FILE__, failed ? "FAILED" : "passed");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file uart_memory_test.c
+ * @brief Host check of the whitelist of uart_memory.c.
+ *
+ * The blocks are checked through the RPC methods in the EEPROM space, which the stub EEPROM below backs with host memory. RAM and flash blocks are only checked where they are denied, their addresses are not valid on the host.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <string.h>
+#include <avr/eeprom.h>
+
+#include "uart_memory.h"
+#include "uart_test.h"
+
+static uint8_t eeprom[0x10000];
+static unsigned int eeprom_writes;
+
+void eeprom_read_block(void *destination, const void *source, size_t length)
+{
+    uintptr_t address = (uintptr_t)source;
+
+    UART_CHECK(address + length <= sizeof(eeprom));
+    memcpy(destination, &eeprom[address], length);
+}
+
+void eeprom_update_block(const void *source, void *destination, size_t length)
+{
+    uintptr_t address = (uintptr_t)destination;
+
+    UART_CHECK(address + length <= sizeof(eeprom));
+    memcpy(&eeprom[address], source, length);
+    eeprom_writes++;
+}
+
+static const UART_Memory_Region regions[] PROGMEM = {
+    { UART_MEMORY_EEPROM, UART_MEMORY_READ | UART_MEMORY_WRITE, 0x0100, 16 },
+    { UART_MEMORY_EEPROM, UART_MEMORY_READ, 0x0200, 8 },
+    { UART_MEMORY_EEPROM, UART_MEMORY_READ | UART_MEMORY_WRITE, 0xFF00, 0x0100 },
+    { UART_MEMORY_RAM, UART_MEMORY_READ, 0x0060, 4 },
+    { UART_MEMORY_FLASH, UART_MEMORY_READ | UART_MEMORY_WRITE, 0x0000, 0x4000 }
+};
+
+/**
+ * @brief Call uart_memory_read() and check the streamed response.
+ *
+ * @return Status of the method.
+ */
+static uint8_t memory_read(uint8_t space, uint16_t address, uint8_t count)
+{
+    uint8_t args[4] = { space, (uint8_t)address, (uint8_t)(address >> 8), count };
+    uint8_t result[UART_RPC_RESULT_MAX];
+    uint8_t size = 0;
+    uint8_t status = uart_memory_read(0x42, args, sizeof(args), result, &size);
+
+    if (status == UART_RPC_DEFERRED)
+    {
+        uint8_t sent[UART_TX_BUFFER_SIZE];
+        uint16_t length = uart_test_transmit(sent, sizeof(sent));
+
+        UART_CHECK(length == count + UART_RPC_HEADER + UART_FRAME_OVERHEAD);
+        UART_CHECK(sent[0] == count + UART_RPC_HEADER);
+        UART_CHECK(sent[1] == 0x42 && sent[2] == UART_RPC_OK && sent[3] == count);
+        UART_CHECK(!memcmp(&sent[4], &eeprom[address], count));
+    }
+    return status;
+}
+
+/**
+ * @brief Call uart_memory_write() with a block of count bytes.
+ *
+ * @return Status of the method.
+ */
+static uint8_t memory_write(uint8_t space, uint16_t address, uint8_t count)
+{
+    uint8_t args[3 + 32] = { space, (uint8_t)address, (uint8_t)(address >> 8) };
+    uint8_t result[UART_RPC_RESULT_MAX];
+    uint8_t size = 0;
+
+    memset(&args[3], 0xA5, count);
+    return uart_memory_write(0x42, args, 3 + count, result, &size);
+}
+
+static void check_read(void)
+{
+    for (unsigned int i = 0; i < sizeof(eeprom); i++)
+    {
+        eeprom[i] = (uint8_t)(i * 7);
+    }
+
+    // Inside and at both edges of a region
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0100, 16) == UART_RPC_DEFERRED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0104, 4) == UART_RPC_DEFERRED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x010F, 1) == UART_RPC_DEFERRED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0200, 8) == UART_RPC_DEFERRED);
+
+    // Outside or across the end of a region
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x00FF, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x00FF, 2) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0100, 17) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0110, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0x0208, 1) == UART_MEMORY_DENIED);
+
+    // Region at the top of the address space, blocks must not wrap around
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0xFFF0, 16) == UART_RPC_DEFERRED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0xFFFF, 1) == UART_RPC_DEFERRED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0xFFF0, 17) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_EEPROM, 0xFFFF, 2) == UART_MEMORY_DENIED);
+
+    // Address in a region of another space
+    UART_CHECK(memory_read(UART_MEMORY_RAM, 0x0100, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_read(UART_MEMORY_FLASH, 0xFF00, 1) == UART_MEMORY_DENIED);
+}
+
+static void check_write(void)
+{
+    eeprom_writes = 0;
+
+    UART_CHECK(memory_write(UART_MEMORY_EEPROM, 0x0100, 16) == UART_RPC_OK);
+    UART_CHECK(memory_write(UART_MEMORY_EEPROM, 0xFFFE, 2) == UART_RPC_OK);
+    UART_CHECK(eeprom[0x010F] == 0xA5 && eeprom[0xFFFF] == 0xA5);
+    UART_CHECK(eeprom_writes == 2);
+
+    // Across the end, read-only region, read-only space
+    UART_CHECK(memory_write(UART_MEMORY_EEPROM, 0x0101, 16) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_write(UART_MEMORY_EEPROM, 0xFFFF, 2) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_write(UART_MEMORY_EEPROM, 0x0200, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_write(UART_MEMORY_RAM, 0x0060, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(memory_write(UART_MEMORY_FLASH, 0x0000, 1) == UART_MEMORY_DENIED);
+    UART_CHECK(eeprom_writes == 2);
+}
+
+static void check_arguments(void)
+{
+    uint8_t args[4] = { UART_MEMORY_EEPROM, 0x00, 0x01, 0 };
+    uint8_t result[UART_RPC_RESULT_MAX];
+    uint8_t size = 0;
+
+    UART_CHECK(uart_memory_read(0, args, 3, result, &size) == UART_RPC_ERROR);
+    UART_CHECK(uart_memory_write(0, args, 2, result, &size) == UART_RPC_ERROR);
+
+    #if UART_FRAME_LENGTH_BYTES == 1
+        args[3] = 255 - UART_RPC_HEADER + 1;
+        UART_CHECK(uart_memory_read(0, args, 4, result, &size) == UART_RPC_ERROR);
+    #endif
+}
+
+int main(void)
+{
+    uart_init();
+    uart_memory_init(regions, sizeof(regions) / sizeof(regions[0]));
+
+    check_read();
+    check_write();
+    check_arguments();
+
+    return UART_TEST_RESULT();
+}
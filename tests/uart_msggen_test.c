@@ -0,0 +1,83 @@
+/**
+ * @file uart_msggen_test.c
+ * @brief Host check of the AVR code generated by tools/uart_msggen.py from tools/messages.idl.
+ *
+ * Encoded messages are compared with the wire format of the IDL (ID, fields little-endian), which uart_msggen_test.cpp checks for the host code, and are read back through the receive queue.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <string.h>
+
+#include "uart_msg.h"
+#include "uart_test.h"
+
+static const uint8_t status_wire[] = { 0x01, 0xE4, 0x0C, 0x83, 0xFF, 0xA5, 0x15, 0xCD, 0x5B, 0x07 };
+static const uint8_t setpoint_wire[] = { 0x02, 0x03, 0x00, 0x00, 0xC0, 0x3F };
+
+static void check_encode(void)
+{
+    struct msg_status status = { 3300, -125, 0xA5, 123456789UL };
+    struct msg_setpoint setpoint = { 3, 1.5f };
+    uint8_t sent[32];
+
+    UART_CHECK(msg_size(MSG_STATUS_ID) == sizeof(status_wire) - 1);
+    UART_CHECK(msg_size(MSG_SAMPLES_ID) == 17);
+    UART_CHECK(msg_size(0x7F) == -1);
+
+    msg_status_write(&status);
+    UART_CHECK(uart_test_transmit(sent, sizeof(sent)) == sizeof(status_wire));
+    UART_CHECK(!memcmp(sent, status_wire, sizeof(status_wire)));
+
+    msg_setpoint_write(&setpoint);
+    UART_CHECK(uart_test_transmit(sent, sizeof(sent)) == sizeof(setpoint_wire));
+    UART_CHECK(!memcmp(sent, setpoint_wire, sizeof(setpoint_wire)));
+
+    // Framed: length prefix, message, CRC
+    UART_CHECK(msg_status_send(&status) == 0);
+    UART_CHECK(uart_test_transmit(sent, sizeof(sent)) == sizeof(status_wire) + UART_FRAME_OVERHEAD);
+    UART_CHECK(sent[0] == sizeof(status_wire));
+    UART_CHECK(!memcmp(&sent[1], status_wire, sizeof(status_wire)));
+}
+
+static void check_decode(void)
+{
+    struct msg_status status;
+    struct msg_setpoint setpoint;
+    char id;
+
+    uart_test_receive(status_wire, sizeof(status_wire), -1);
+    UART_CHECK(uart_scanchar(&id) == UART_Received && (uint8_t)id == MSG_STATUS_ID);
+    UART_CHECK(msg_status_read(&status) == UART_Received);
+    UART_CHECK(status.voltage == 3300 && status.temperature == -125 && status.flags == 0xA5 && status.uptime == 123456789UL);
+
+    memset(&status, 0, sizeof(status));
+    UART_CHECK(msg_status_decode(status_wire, sizeof(status_wire), &status) == 0);
+    UART_CHECK(status.voltage == 3300 && status.temperature == -125 && status.flags == 0xA5 && status.uptime == 123456789UL);
+
+    UART_CHECK(msg_setpoint_decode(setpoint_wire, sizeof(setpoint_wire), &setpoint) == 0);
+    UART_CHECK(setpoint.channel == 3 && setpoint.value == 1.5f);
+
+    // Wrong ID, too short
+    UART_CHECK(msg_setpoint_decode(status_wire, sizeof(status_wire), &setpoint) != 0);
+    UART_CHECK(msg_status_decode(status_wire, sizeof(status_wire) - 1, &status) != 0);
+}
+
+int main(void)
+{
+    uart_init();
+
+    check_encode();
+    check_decode();
+
+    return UART_TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file uart_peer_test.cpp
+ * @brief Host check of the frame receiver of host/uart_peer.cpp.
+ *
+ * Frames are written into the master side of a pseudo terminal and read with uart::Peer::frame(). A corrupted length prefix must be dropped instead of stalling the receiver.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_peer.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    int failed = 0;
+
+    #define UART_CHECK(condition) \
+        do { if (!(condition)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); failed++; } } while (0)
+
+    std::uint16_t crc_xmodem(const std::uint8_t *data, std::size_t length)
+    {
+        std::uint16_t crc = 0;
+
+        while (length--)
+        {
+            crc ^= static_cast<std::uint16_t>(*data++ << 8);
+
+            for (int i = 0; i < 8; i++)
+            {
+                crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Append a frame with 1 byte length prefix and big-endian CRC.
+     */
+    void frame(std::vector<std::uint8_t> &out, const char *payload)
+    {
+        std::size_t start = out.size();
+        std::size_t length = std::strlen(payload);
+
+        out.push_back(static_cast<std::uint8_t>(length));
+        out.insert(out.end(), payload, payload + length);
+
+        std::uint16_t crc = crc_xmodem(&out[start], length + 1);
+
+        out.push_back(static_cast<std::uint8_t>(crc >> 8));
+        out.push_back(static_cast<std::uint8_t>(crc));
+    }
+
+    /**
+     * @brief Write the bytes to the peer and take the next frame.
+     */
+    bool receive(uart::Peer &peer, int master, const std::vector<std::uint8_t> &data, uart::View &payload)
+    {
+        if (!data.empty() && ::write(master, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+        {
+            return false;
+        }
+
+        for (int i = 0; i < 10; i++)
+        {
+            if (peer.frame(payload))
+            {
+                return true;
+            }
+            peer.poll(100);
+        }
+        return false;
+    }
+
+    bool equal(const uart::View &payload, const char *expected)
+    {
+        return payload.size == std::strlen(expected) && !std::memcmp(payload.data, expected, payload.size);
+    }
+}
+
+int main()
+{
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0)
+    {
+        std::perror("posix_openpt");
+        return EXIT_FAILURE;
+    }
+
+    uart::Config config;
+    config.frame_max = 16;
+    config.buffer_size = 64;
+
+    uart::Peer peer(::ptsname(master), config);
+    uart::View payload;
+    std::vector<std::uint8_t> data;
+
+    frame(data, "first");
+    UART_CHECK(receive(peer, master, data, payload) && equal(payload, "first"));
+    UART_CHECK(peer.frame_rejected() == 0);
+
+    // Length prefix above frame_max, the following frame is found without further input
+    data.assign(1, 200);
+    frame(data, "second");
+    UART_CHECK(receive(peer, master, data, payload) && equal(payload, "second"));
+    UART_CHECK(peer.frame_rejected() == 1);
+
+    // Corrupted CRC
+    data.clear();
+    frame(data, "third");
+    data[3] ^= 0x01;
+    frame(data, "fourth");
+    UART_CHECK(receive(peer, master, data, payload) && equal(payload, "fourth"));
+    UART_CHECK(peer.frame_rejected() >= 1);
+
+    // Without frame_max the frame buffer is the limit
+    config.frame_max = 0;
+    config.frame_length_bytes = 2;
+
+    uart::Peer wide(::ptsname(master), config);
+
+    data = { 0x40, 0x00, 0x00, 0x03, 'a', 'b', 'c' };
+    std::uint16_t crc = crc_xmodem(&data[2], 5);
+    data.push_back(static_cast<std::uint8_t>(crc >> 8));
+    data.push_back(static_cast<std::uint8_t>(crc));
+    UART_CHECK(receive(wide, master, data, payload) && equal(payload, "abc"));
+    UART_CHECK(wide.frame_rejected() == 2);
+
+    ::close(master);
+
+    std::fprintf(stderr, "%s: %s\n", __FILE__, failed ? "FAILED" : "passed");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
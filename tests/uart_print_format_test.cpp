@@ -0,0 +1,102 @@
+/**
+ * @file uart_print_format_test.cpp
+ * @brief Host check of the compile-time format front end of uart_print.hpp.
+ *
+ * uart_print.c is compiled as C and linked, so the check also covers the extern "C" declarations of uart.h and uart_print.h. uart_putchar() is replaced by a capture buffer. Built with -DUART_PRINT_REJECT=<n> the file must not compile, each case is one of the compile-time errors.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <string.h>
+
+#include "uart_print.hpp"
+#include "uart_test.h"
+
+static char output[64];
+static unsigned char position;
+
+char uart_putchar(char data)
+{
+    if (position < sizeof(output) - 1)
+    {
+        output[position++] = data;
+        output[position] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @def PRINTS
+ * @brief Check the characters transmitted by a print call.
+ */
+#define PRINTS(call, expected) \
+    do { position = 0; output[0] = '\0'; call; UART_CHECK(!strcmp(output, expected)); } while (0)
+
+static void check_format(void)
+{
+    unsigned int whole = 21;
+    unsigned char fraction = 5;
+    int32_t negative = -42;
+    const char *name = "adc";
+
+    PRINTS(UART_PRINTF("T=%u.%02u C\n", whole, fraction), "T=21.05 C\n");
+    PRINTS(UART_PRINTF("%d|%6d|%06i", negative, negative, negative), "-42|   -42|-00042");
+    PRINTS(UART_PRINTF("%lu", (uint32_t)4294967295UL), "4294967295");
+    PRINTS(UART_PRINTF("0x%X 0x%2X", (uint16_t)0xBEEF, (uint8_t)0x0A), "0xBEEF 0x0A");
+    PRINTS(UART_PRINTF("%c%s%S", '>', name, PSTR("!")), ">adc!");
+    PRINTS(UART_PRINTF("%.2f", 3.14159f), "3.14");
+    PRINTS(UART_PRINTF("100%%"), "100%");
+    PRINTS(UART_PRINTF("plain"), "plain");
+    PRINTS(UART_PRINTF(""), "");
+
+    #if __cplusplus >= 202002L
+        PRINTS(uart::print<"T=%u.%02u C\n">(whole, fraction), "T=21.05 C\n");
+        PRINTS(uart::print<"%s=%X">(name, (uint8_t)0x7F), "adc=7F");
+    #endif
+}
+
+static void check_parse(void)
+{
+    using namespace uart::detail;
+
+    constexpr Spec spec = parse("ab%08lu", 0);
+    static_assert(spec.begin == 2 && spec.end == 7, "position of the conversion");
+    static_assert(spec.conversion == Conversion::Unsigned && spec.width == 8 && spec.fill == '0', "width and fill");
+
+    static_assert(parse("%.3f", 0).precision == 3, "precision");
+    static_assert(parse("%x", 0).conversion == Conversion::Invalid, "lower case hexadecimal");
+    static_assert(parse("%5s", 0).conversion == Conversion::Invalid, "width of a string");
+    static_assert(parse("%", 0).conversion == Conversion::Invalid, "incomplete conversion");
+    static_assert(parse("text", 0).conversion == Conversion::End && parse("text", 0).begin == 4, "literal only");
+    static_assert(accepts<uint8_t>(Conversion::Unsigned) && !accepts<int>(Conversion::Unsigned), "signedness");
+    static_assert(!accepts<long long>(Conversion::Signed), "wider than 32 bit");
+}
+
+int main(void)
+{
+    #if UART_PRINT_REJECT == 1
+        UART_PRINTF("%u", -1);
+    #elif UART_PRINT_REJECT == 2
+        UART_PRINTF("%u %u", 1U);
+    #elif UART_PRINT_REJECT == 3
+        UART_PRINTF("%u", 1U, 2U);
+    #elif UART_PRINT_REJECT == 4
+        UART_PRINTF("%x", 1U);
+    #elif UART_PRINT_REJECT == 5
+        UART_PRINTF("%s", 'c');
+    #endif
+
+    check_format();
+    check_parse();
+
+    return UART_TEST_RESULT();
+}
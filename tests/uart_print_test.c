@@ -0,0 +1,98 @@
+/**
+ * @file uart_print_test.c
+ * @brief Host check of the number conversions of uart_print.c.
+ *
+ * uart_putchar() is replaced by a capture buffer, so only uart_print.c is linked.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "uart_print.h"
+#include "uart_test.h"
+
+static char output[64];
+static unsigned char position;
+
+char uart_putchar(char data)
+{
+    if (position < sizeof(output) - 1)
+    {
+        output[position++] = data;
+        output[position] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @def PRINTS
+ * @brief Check the characters transmitted by a print call.
+ */
+#define PRINTS(call, expected) \
+    do { position = 0; output[0] = '\0'; call; UART_CHECK(!strcmp(output, expected)); } while (0)
+
+static void check_integer(void)
+{
+    PRINTS(uart_print_unsigned(0, 0, ' '), "0");
+    PRINTS(uart_print_unsigned(4294967295UL, 0, ' '), "4294967295");
+    PRINTS(uart_print_unsigned(7, 3, '0'), "007");
+    PRINTS(uart_print_unsigned(12345, 3, ' '), "12345");
+    PRINTS(uart_print_signed(-42, 6, '0'), "-00042");
+    PRINTS(uart_print_signed(-42, 6, ' '), "   -42");
+    PRINTS(uart_print_signed(INT32_MIN, 0, ' '), "-2147483648");
+    PRINTS(uart_print_hex(0xBEEF, 6), "00BEEF");
+}
+
+static void check_decimal(void)
+{
+    PRINTS(uart_print_decimal(2345, 2), "23.45");
+    PRINTS(uart_print_decimal(5, 3), "0.005");
+    PRINTS(uart_print_decimal(-5, 1), "-0.5");
+    PRINTS(uart_print_decimal(100, 2), "1.00");
+    PRINTS(uart_print_decimal(7, 0), "7");
+    PRINTS(uart_print_decimal(INT32_MIN, 2), "-21474836.48");
+}
+
+static void check_fixed(void)
+{
+    PRINTS(uart_print_fixed(0x18000, 16, 2), "1.50");
+    PRINTS(uart_print_fixed(-0x18000, 16, 0), "-2");
+    PRINTS(uart_print_fixed(0xFFFF, 16, 3), "1.000");
+    PRINTS(uart_print_fixed(1L << 27, 28, 9), "0.500000000");
+}
+
+static void check_float(void)
+{
+    PRINTS(uart_print_float(3.14159f, 4), "3.1416");
+    PRINTS(uart_print_float(-2.5f, 4), "-2.5000");
+    PRINTS(uart_print_float(0.0f, 2), "0.00");
+    PRINTS(uart_print_float(0.999999f, 4), "1.0000");
+    PRINTS(uart_print_float(-0.0049f, 4), "-0.0049");
+    PRINTS(uart_print_float(4.2e9f, 1), "4200000000.0");
+    PRINTS(uart_print_float(1e-40f, 3), "0.000");
+    PRINTS(uart_print_float(16777216.0f, 1), "16777216.0");
+    PRINTS(uart_print_float(5e9f, 1), "ovf");
+    PRINTS(uart_print_float(INFINITY, 1), "inf");
+    PRINTS(uart_print_float(NAN, 1), "nan");
+}
+
+int main(void)
+{
+    check_integer();
+    check_decimal();
+    check_fixed();
+    check_float();
+
+    return UART_TEST_RESULT();
+}
@@ -0,0 +1,185 @@
+/**
+ * @file uart_rpc_test.cpp
+ * @brief Host check of the request batching of host/uart_rpc.cpp.
+ *
+ * The client writes into a pseudo terminal, the check reads the frames from the master side, verifies length prefix and CRC and that every frame holds whole requests within max_frame.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_rpc.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    int failed = 0;
+
+    #define UART_CHECK(condition) \
+        do { if (!(condition)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); failed++; } } while (0)
+
+    constexpr std::size_t header = 3;
+
+    std::uint16_t crc_xmodem(const std::uint8_t *data, std::size_t length)
+    {
+        std::uint16_t crc = 0;
+
+        while (length--)
+        {
+            crc ^= static_cast<std::uint16_t>(*data++ << 8);
+
+            for (int i = 0; i < 8; i++)
+            {
+                crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021) : static_cast<std::uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Read everything the client has written so far.
+     */
+    std::vector<std::uint8_t> drain(int master)
+    {
+        std::vector<std::uint8_t> data;
+        std::uint8_t buffer[256];
+        pollfd descriptor = { master, POLLIN, 0 };
+
+        while (::poll(&descriptor, 1, 100) > 0)
+        {
+            ssize_t count = ::read(master, buffer, sizeof(buffer));
+
+            if (count <= 0)
+            {
+                break;
+            }
+            data.insert(data.end(), buffer, buffer + count);
+        }
+        return data;
+    }
+
+    /**
+     * @brief Split the written bytes into frame payloads (1 byte length prefix, CRC).
+     */
+    std::vector<std::vector<std::uint8_t>> frames(const std::vector<std::uint8_t> &data)
+    {
+        std::vector<std::vector<std::uint8_t>> result;
+        std::size_t position = 0;
+
+        while (position < data.size())
+        {
+            std::size_t length = data[position];
+
+            if (position + 1 + length + 2 > data.size())
+            {
+                UART_CHECK(!"truncated frame");
+                break;
+            }
+
+            UART_CHECK(crc_xmodem(&data[position], 1 + length + 2) == 0);
+            result.emplace_back(data.begin() + position + 1, data.begin() + position + 1 + length);
+            position += 1 + length + 2;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Queue requests with the given argument lengths, send them and check the frames.
+     *
+     * @return Number of frames.
+     */
+    std::size_t batch(uart::RpcClient &client, int master, std::size_t max_frame, const std::vector<std::size_t> &lengths)
+    {
+        std::vector<int> ids;
+
+        for (std::size_t i = 0; i < lengths.size(); i++)
+        {
+            std::vector<std::uint8_t> args(lengths[i], static_cast<std::uint8_t>(i));
+
+            ids.push_back(client.call(static_cast<std::uint8_t>(i), args.data(), args.size()));
+        }
+        UART_CHECK(client.send(1000));
+
+        std::vector<std::vector<std::uint8_t>> payloads = frames(drain(master));
+        std::size_t request = 0;
+
+        for (const std::vector<std::uint8_t> &payload : payloads)
+        {
+            std::size_t position = 0;
+
+            UART_CHECK(!payload.empty() && payload.size() <= max_frame);
+
+            // Whole requests only, in call order
+            while (position + header <= payload.size() && request < lengths.size())
+            {
+                UART_CHECK(payload[position] == ids[request]);
+                UART_CHECK(payload[position + 1] == static_cast<std::uint8_t>(request));
+                UART_CHECK(payload[position + 2] == lengths[request]);
+                position += header + payload[position + 2];
+                request++;
+            }
+            UART_CHECK(position == payload.size());
+        }
+        UART_CHECK(request == lengths.size());
+        return payloads.size();
+    }
+}
+
+int main()
+{
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0)
+    {
+        std::perror("posix_openpt");
+        return EXIT_FAILURE;
+    }
+
+    uart::Peer peer(::ptsname(master));
+    uart::RpcClient client(peer, 16);
+
+    // Fits into one frame
+    UART_CHECK(batch(client, master, 16, { 0, 2, 5 }) == 1);
+
+    // Exactly max_frame, then one byte more
+    UART_CHECK(batch(client, master, 16, { 5, 5 }) == 1);
+    UART_CHECK(batch(client, master, 16, { 5, 6 }) == 2);
+
+    // Largest request alone, small requests fill up the following frames
+    UART_CHECK(batch(client, master, 16, { 13, 0, 0, 0, 0, 0, 1, 13 }) == 4);
+    UART_CHECK(batch(client, master, 16, std::vector<std::size_t>(20, 1)) == 5);
+
+    // Requests that never fit
+    try
+    {
+        client.call(0, nullptr, 14);
+        UART_CHECK(!"request longer than max_frame accepted");
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+
+    UART_CHECK(client.send(1000));
+    UART_CHECK(drain(master).empty());
+
+    ::close(master);
+
+    std::fprintf(stderr, "%s: %s\n", __FILE__, failed ? "FAILED" : "passed");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file uart_test.h
+ * @brief Header file with the helpers of the host checks.
+ *
+ * This file provides the check macro and, for buffered configurations, the functions that act as the USART: they call the ISRs of uart.c and move the bytes through UDR.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_TEST_H_
+#define UART_TEST_H_
+
+    #include <stdint.h>
+    #include <stdio.h>
+
+    static int uart_test_failed;
+
+    /**
+     * @def UART_CHECK
+     * @brief Report a failed condition with its location, the check continues.
+     */
+    #define UART_CHECK(condition) \
+        do { if (!(condition)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); uart_test_failed++; } } while (0)
+
+    /**
+     * @def UART_TEST_RESULT
+     * @brief Exit code of main(), prints the summary.
+     */
+    #define UART_TEST_RESULT() \
+        (fprintf(stderr, "%s: %s\n", __FILE__, uart_test_failed ? "FAILED" : "passed"), uart_test_failed ? 1 : 0)
+
+    #ifdef UART_H_
+        #if UART_TX_BUFFER_SIZE > 0
+            void UART_UDRE_vect(void);
+
+            /**
+             * @brief Transmit the queued bytes.
+             *
+             * @param[out] data Transmitted bytes.
+             * @param size Size of data.
+             * @return Number of transmitted bytes.
+             */
+            static uint16_t uart_test_transmit(uint8_t *data, uint16_t size)
+            {
+                uint16_t count = 0;
+
+                while ((UCSRB & (1<<UDRIE)) && count < size)
+                {
+                    UART_UDRE_vect();
+                    data[count++] = UDR;
+                }
+                return count;
+            }
+        #endif
+
+        #if UART_RX_BUFFER_SIZE > 0
+            void UART_RXC_vect(void);
+
+            /**
+             * @brief Receive bytes.
+             *
+             * @param data Received bytes.
+             * @param length Number of bytes.
+             * @param fault Index of the byte that is received with a frame error (-1 = none).
+             */
+            static void uart_test_receive(const uint8_t *data, uint16_t length, int fault)
+            {
+                for (uint16_t i = 0; i < length; i++)
+                {
+                    UCSRA = (1<<UDRE) | (1<<TXC) | (1<<RXC) | ((int)i == fault ? (1<<FE) : 0);
+                    UDR = data[i];
+                    UART_RXC_vect();
+                }
+                UCSRA = (1<<UDRE) | (1<<TXC);
+            }
+        #endif
+    #endif
+
+#endif /* UART_TEST_H_ */
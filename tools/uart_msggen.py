@@ -0,0 +1,396 @@
+#!/usr/bin/env python3
+"""
+@file uart_msggen.py
+@brief Message code generator for the AVR UART driver and its Linux host counterpart.
+
+Reads a message description (IDL) and generates
+- <name>.h/<name>.c: AVR encoders/decoders that stream every field directly with
+  uart_putchar()/uart_getchar() (and uart_frame_begin()/uart_frame_put()/uart_frame_end()
+  with UART_FRAME), no intermediate buffer, sizes known at compile time.
+- <name>.hpp: host encoders/decoders for the uart::Peer library.
+
+IDL syntax (one declaration per line, '#' starts a comment):
+
+    message <Name> <id>
+        <type> <field>
+        <type>[<count>] <field>
+
+Types: uint8, int8, uint16, int16, uint32, int32, float. Message IDs are 0-255 and unique,
+a message has at most 32767 bytes (without ID). A message that does not fit into a frame with
+a 1 byte length prefix stops the build of <name>.c with UART_FRAME_LENGTH_BYTES 1.
+On the wire a message is its ID byte followed by all fields in declaration order,
+multi-byte values little-endian (native AVR byte order).
+
+Usage: uart_msggen.py [--prefix NAME] [--output DIR] messages.idl
+
+@author g.raf
+@date 2026-10-18
+@version 1.0 Release
+@copyright
+Copyright (c) 2026 g.raf
+Released under the GPLv3 License. (see LICENSE in repository)
+
+@note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+
+@see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# IDL type: (C type, host type, size in bytes)
+TYPES = {
+    "uint8":  ("uint8_t",  "std::uint8_t",  1),
+    "int8":   ("int8_t",   "std::int8_t",   1),
+    "uint16": ("uint16_t", "std::uint16_t", 2),
+    "int16":  ("int16_t",  "std::int16_t",  2),
+    "uint32": ("uint32_t", "std::uint32_t", 4),
+    "int32":  ("int32_t",  "std::int32_t",  4),
+    "float":  ("float",    "float",         4),
+}
+
+IDENTIFIER = r"[A-Za-z_][A-Za-z0-9_]*"
+
+# Largest encoded message without ID
+SIZE_MAX = 32767
+
+HEADER = """/**
+ * @file {file}
+ * @brief {brief}
+ *
+ * Generated by tools/uart_msggen.py from {source}, do not edit.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+"""
+
+
+class Field:
+    def __init__(self, kind, name, count):
+        self.kind = kind
+        self.name = name
+        self.count = count
+
+    @property
+    def size(self):
+        return TYPES[self.kind][2] * (self.count or 1)
+
+
+class Message:
+    def __init__(self, name, ident):
+        self.name = name
+        self.ident = ident
+        self.fields = []
+
+    @property
+    def size(self):
+        return sum(field.size for field in self.fields)
+
+
+def parse(path):
+    messages = []
+
+    with open(path) as source:
+        for number, line in enumerate(source, 1):
+            line = line.split("#", 1)[0].strip()
+
+            if not line:
+                continue
+
+            match = re.fullmatch(r"message\s+(" + IDENTIFIER + r")\s+(0x[0-9A-Fa-f]+|\d+)", line)
+
+            if match:
+                ident = int(match.group(2), 0)
+
+                if ident > 255 or any(message.ident == ident for message in messages):
+                    sys.exit("%s:%d: message ID %d out of range or not unique" % (path, number, ident))
+
+                if any(message.name == match.group(1) for message in messages):
+                    sys.exit("%s:%d: message %s declared twice" % (path, number, match.group(1)))
+
+                messages.append(Message(match.group(1), ident))
+                continue
+
+            match = re.fullmatch(r"(\w+)(?:\[(\d+)\])?\s+(" + IDENTIFIER + r")", line)
+
+            if not match or match.group(1) not in TYPES:
+                sys.exit("%s:%d: syntax error" % (path, number))
+
+            if not messages:
+                sys.exit("%s:%d: field outside of a message" % (path, number))
+
+            count = int(match.group(2)) if match.group(2) else 0
+
+            if match.group(2) and not 1 <= count <= 255:
+                sys.exit("%s:%d: array size has to be 1-255" % (path, number))
+
+            if any(field.name == match.group(3) for field in messages[-1].fields):
+                sys.exit("%s:%d: field %s declared twice" % (path, number, match.group(3)))
+
+            messages[-1].fields.append(Field(match.group(1), match.group(3), count))
+
+            # <prefix>_size() returns int16_t
+            if messages[-1].size > SIZE_MAX:
+                sys.exit("%s:%d: message %s exceeds %d bytes" % (path, number, messages[-1].name, SIZE_MAX))
+
+    if not messages:
+        sys.exit("%s: no messages" % path)
+
+    return messages
+
+
+def snake(name):
+    return re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", name).lower()
+
+
+def generate_c_header(messages, prefix, source, name):
+    guard = name.upper() + "_H_"
+    out = [HEADER.format(file=name + ".h", brief="Header file with generated message encoders/decoders for the UART driver.", source=source)]
+    out.append("#ifndef %s\n#define %s\n" % (guard, guard))
+    out.append("    #include <stdint.h>\n")
+    out.append("    #include \"uart.h\"\n")
+
+    for message in messages:
+        upper = "%s_%s" % (prefix.upper(), snake(message.name).upper())
+        out.append("    /**\n     * @def %s_ID\n     * @brief Message ID of %s.\n     */\n    #define %s_ID %d\n" % (upper, message.name, upper, message.ident))
+        out.append("    /**\n     * @def %s_SIZE\n     * @brief Encoded size of %s in bytes (without ID).\n     */\n    #define %s_SIZE %d\n" % (upper, message.name, upper, message.size))
+
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("    /**\n     * @brief Message %s (ID %d, %d bytes).\n     */" % (message.name, message.ident, message.size))
+        out.append("    struct %s\n    {" % lower)
+        for field in message.fields:
+            array = "[%d]" % field.count if field.count else ""
+            out.append("        %s %s%s;" % (TYPES[field.kind][0], field.name, array))
+        out.append("    };\n")
+
+    out.append("    int16_t %s_size(uint8_t id);\n" % prefix)
+    out.append("    #if !defined(UART_TXCIE) && !defined(UART_UDRIE)")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("        void %s_write(const struct %s *message);" % (lower, lower))
+    out.append("\n        #if UART_FRAME > 0")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("            char %s_send(const struct %s *message);" % (lower, lower))
+    out.append("        #endif\n    #endif\n")
+    out.append("    #if !defined(UART_RXCIE)")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("        UART_Data %s_read(struct %s *message);" % (lower, lower))
+    out.append("    #endif\n")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("    char %s_decode(const uint8_t *data, uint16_t length, struct %s *message);" % (lower, lower))
+    out.append("\n#endif /* %s */" % guard)
+    return "\n".join(out) + "\n"
+
+
+def generate_c_source(messages, prefix, source, name):
+    out = [HEADER.format(file=name + ".c", brief="Source file with generated message encoders/decoders for the UART driver.", source=source)]
+    out.append("#include \"%s.h\"\n" % name)
+
+    # Size lookup
+    out.append("/**\n * @brief Encoded size of a message.\n *\n * @param id Message ID.\n * @return Size in bytes without ID, -1 if the ID is unknown.\n */")
+    out.append("int16_t %s_size(uint8_t id)\n{\n    switch (id)\n    {" % prefix)
+    for message in messages:
+        upper = "%s_%s" % (prefix.upper(), snake(message.name).upper())
+        out.append("        case %s_ID:\n            return %s_SIZE;" % (upper, upper))
+    out.append("        default:\n            return -1;\n    }\n}\n")
+
+    # Streaming writers
+    out.append("#if !defined(UART_TXCIE) && !defined(UART_UDRIE)")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        upper = lower.upper()
+        out.append("    /**\n     * @brief Transmit %s (ID and fields) with uart_putchar().\n     *\n     * @param message Message to transmit.\n     */" % message.name)
+        out.append("    void %s_write(const struct %s *message)\n    {" % (lower, lower))
+        out.append("        uart_putchar((char)%s_ID);" % upper)
+        for field in message.fields:
+            out.extend(field_code(field, "uart_putchar((char)%s);", "write"))
+        out.append("    }\n")
+
+    out.append("    #if UART_FRAME > 0")
+    for message in messages:
+        if 1 + message.size > 255:
+            upper = "%s_%s" % (prefix.upper(), snake(message.name).upper())
+            out.append("        #if UART_FRAME_LENGTH_BYTES == 1 && (1 + %s_SIZE) > 255" % upper)
+            out.append("            #error \"%s does not fit into a frame with a 1 byte length prefix, use UART_FRAME_LENGTH_BYTES 2\"" % message.name)
+            out.append("        #endif\n")
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        upper = lower.upper()
+        out.append("        /**\n         * @brief Transmit %s as one frame, the fields are streamed into the frame.\n         *\n         * @param message Message to transmit.\n         * @return 0 on success, 1 if the frame has been discarded.\n         *\n         * @details\n         * Fields are put from their memory, AVR byte order is the wire byte order.\n         */" % message.name)
+        out.append("        char %s_send(const struct %s *message)\n        {" % (lower, lower))
+        out.append("            const uint8_t id = %s_ID;\n" % upper)
+        out.append("            uart_frame_begin(1 + %s_SIZE);" % upper)
+        out.append("            uart_frame_put(&id, 1);")
+        for field in message.fields:
+            out.append("            uart_frame_put(%smessage->%s, %d);" % ("" if field.count else "&", field.name, field.size))
+        out.append("            return uart_frame_end();\n        }\n")
+    out[-1] = out[-1].rstrip("\n")
+    out.append("    #endif\n#endif\n")
+
+    # Streaming readers
+    out.append("#if !defined(UART_RXCIE)")
+    out.append("    /**\n     * @brief Receive one byte, a fault is kept in status.\n     *\n     * @param[in,out] status UART_Received, set to UART_Fault on a receive error.\n     * @return Received byte.\n     */")
+    out.append("    static uint8_t %s_get(UART_Data *status)\n    {\n        UART_Data result;\n        uint8_t data = (uint8_t)uart_getchar(&result);\n\n        if (result != UART_Received)\n        {\n            *status = result;\n        }\n        return data;\n    }\n" % prefix)
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        out.append("    /**\n     * @brief Receive the fields of %s with uart_getchar() (blocking).\n     *\n     * @param[out] message Received message.\n     * @return UART_Received, or UART_Fault if a byte had a receive error.\n     *\n     * @note The ID has already been read by the caller (see %s_size()).\n     */" % (message.name, prefix))
+        out.append("    UART_Data %s_read(struct %s *message)\n    {" % (lower, lower))
+        out.append("        UART_Data status = UART_Received;\n")
+        for field in message.fields:
+            out.extend(field_code(field, "%s_get(&status);" % prefix, "read"))
+        out.append("        return status;\n    }\n")
+    out[-1] = out[-1].rstrip("\n")
+    out.append("#endif\n")
+
+    # Buffer decoders (frame payloads)
+    for message in messages:
+        lower = "%s_%s" % (prefix, snake(message.name))
+        upper = lower.upper()
+        out.append("/**\n * @brief Decode %s from a buffer (e.g. a frame payload of uart_frame_read()).\n *\n * @param data Encoded message including the ID.\n * @param length Number of bytes in data.\n * @param[out] message Decoded message.\n * @return 0 on success, 1 if ID or length do not match.\n */" % message.name)
+        out.append("char %s_decode(const uint8_t *data, uint16_t length, struct %s *message)\n{" % (lower, lower))
+        out.append("    if (length < 1 + %s_SIZE || data[0] != %s_ID)\n    {\n        return 1;\n    }\n    data++;\n" % (upper, upper))
+        for field in message.fields:
+            out.extend(line[4:] for line in field_code(field, "*data++;", "read"))
+        out.append("    return 0;\n}\n")
+
+    return "\n".join(out).rstrip("\n") + "\n"
+
+
+def field_code(field, pattern, direction):
+    """C statements of one field at 8 spaces indentation."""
+    indent = " " * 8
+    lines = []
+
+    if field.count:
+        lines.append("%sfor (uint8_t i = 0; i < %d; i++)" % (indent, field.count))
+        lines.append("%s{" % indent)
+        lines.extend(value_code(field, "message->%s[i]" % field.name, pattern, direction, indent + "    "))
+        lines.append("%s}" % indent)
+    else:
+        lines.extend(value_code(field, "message->%s" % field.name, pattern, direction, indent))
+
+    return lines
+
+
+def value_code(field, access, pattern, direction, indent):
+    """Straight-line byte statements of one value, little-endian."""
+    c_type, _, size = TYPES[field.kind]
+
+    if field.kind == "float":
+        cast = "const uint8_t" if direction == "write" else "uint8_t"
+        if direction == "write":
+            return ["%s%s" % (indent, pattern % ("((%s *)&%s)[%d]" % (cast, access, i))) for i in range(size)]
+        return ["%s((%s *)&%s)[%d] = %s" % (indent, cast, access, i, pattern) for i in range(size)]
+
+    unsigned = "uint%d_t" % (8 * size)
+
+    if direction == "write":
+        lines = []
+        for i in range(size):
+            value = "(uint8_t)((%s)%s >> %d)" % (unsigned, access, 8 * i) if i else "(uint8_t)%s" % access
+            lines.append("%s%s" % (indent, pattern % value))
+        return lines
+
+    # Read: pattern is the byte expression with semicolon, signed values are assembled through their unsigned alias
+    target = access if c_type.startswith("uint") else "*(%s *)&%s" % (unsigned, access)
+
+    if size == 1:
+        return ["%s%s = %s" % (indent, target, pattern)]
+
+    lines = ["%s%s = (%s)%s" % (indent, target, unsigned, pattern)]
+    lines.extend("%s%s |= (%s)%s << %d;" % (indent, target, unsigned, pattern[:-1], 8 * i) for i in range(1, size))
+    return lines
+
+
+def generate_host(messages, prefix, source, name):
+    guard = name.upper() + "_HPP_"
+    out = [HEADER.format(file=name + ".hpp", brief="Header file with generated host message encoders/decoders for the uart::Peer library.", source=source)]
+    out.append("#ifndef %s\n#define %s\n" % (guard, guard))
+    out.append("#include <cstddef>\n#include <cstdint>\n#include <cstring>\n#include <vector>\n")
+    out.append("namespace %s\n{" % prefix)
+    out.append("    namespace detail\n    {")
+    out.append("        template <typename T>\n        void put(std::vector<std::uint8_t> &out, T value)\n        {\n            std::uint8_t bytes[sizeof(T)];\n\n            std::memcpy(bytes, &value, sizeof(T));\n\n            // Little-endian on the wire, independent of the host byte order\n            for (std::size_t i = 0; i < sizeof(T); i++)\n            {\n                out.push_back(bytes[is_little() ? i : sizeof(T) - 1 - i]);\n            }\n        }\n")
+    out.append("        template <typename T>\n        T get(const std::uint8_t *&data)\n        {\n            std::uint8_t bytes[sizeof(T)];\n            T value;\n\n            for (std::size_t i = 0; i < sizeof(T); i++)\n            {\n                bytes[is_little() ? i : sizeof(T) - 1 - i] = *data++;\n            }\n            std::memcpy(&value, bytes, sizeof(T));\n            return value;\n        }\n    }\n")
+    # is_little has to be declared before the templates
+    out.insert(len(out) - 2, "        inline bool is_little()\n        {\n            const std::uint16_t probe = 1;\n            return *reinterpret_cast<const std::uint8_t *>(&probe) == 1;\n        }\n")
+
+    for message in messages:
+        out.append("    /**\n     * @brief Message %s (ID %d, %d bytes).\n     */" % (message.name, message.ident, message.size))
+        out.append("    struct %s\n    {" % message.name)
+        out.append("        static constexpr std::uint8_t id = %d;" % message.ident)
+        out.append("        static constexpr std::size_t size = %d;\n" % message.size)
+        for field in message.fields:
+            array = "[%d]" % field.count if field.count else ""
+            out.append("        %s %s%s = {};" % (TYPES[field.kind][1], field.name, array))
+        out.append("    };\n")
+
+    out.append("    /**\n     * @brief Encoded size of a message without ID, -1 if the ID is unknown.\n     */")
+    out.append("    inline int size(std::uint8_t id)\n    {\n        switch (id)\n        {")
+    for message in messages:
+        out.append("            case %s::id: return %s::size;" % (message.name, message.name))
+    out.append("            default: return -1;\n        }\n    }\n")
+
+    for message in messages:
+        out.append("    /**\n     * @brief Append %s (ID and fields) to out, e.g. for uart::Peer::write() or write_frame().\n     */" % message.name)
+        out.append("    inline void encode(const %s &message, std::vector<std::uint8_t> &out)\n    {" % message.name)
+        out.append("        out.push_back(%s::id);" % message.name)
+        for field in message.fields:
+            host = TYPES[field.kind][1]
+            if field.count:
+                out.append("        for (std::size_t i = 0; i < %d; i++)\n        {\n            detail::put<%s>(out, message.%s[i]);\n        }" % (field.count, host, field.name))
+            else:
+                out.append("        detail::put<%s>(out, message.%s);" % (host, field.name))
+        out.append("    }\n")
+
+        out.append("    /**\n     * @brief Decode %s from data (including the ID), e.g. a uart::View.\n     *\n     * @return false if ID or length do not match.\n     */" % message.name)
+        out.append("    inline bool decode(const std::uint8_t *data, std::size_t length, %s &message)\n    {" % message.name)
+        out.append("        if (length < 1 + %s::size || data[0] != %s::id)\n        {\n            return false;\n        }\n        data++;\n" % (message.name, message.name))
+        for field in message.fields:
+            host = TYPES[field.kind][1]
+            if field.count:
+                out.append("        for (std::size_t i = 0; i < %d; i++)\n        {\n            message.%s[i] = detail::get<%s>(data);\n        }" % (field.count, field.name, host))
+            else:
+                out.append("        message.%s = detail::get<%s>(data);" % (field.name, host))
+        out.append("        return true;\n    }\n")
+
+    out[-1] = out[-1].rstrip("\n")
+    out.append("}\n\n#endif /* %s */" % guard)
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate UART message encoders/decoders from an IDL file.")
+    parser.add_argument("idl", help="message description")
+    parser.add_argument("--prefix", default="msg", help="prefix of generated identifiers (default: msg)")
+    parser.add_argument("--output", default=".", help="output directory (default: current directory)")
+    parser.add_argument("--name", help="base name of the generated files (default: uart_<prefix>)")
+    arguments = parser.parse_args()
+
+    if not re.fullmatch(IDENTIFIER, arguments.prefix):
+        sys.exit("invalid prefix: %s" % arguments.prefix)
+
+    messages = parse(arguments.idl)
+    name = arguments.name or "uart_" + arguments.prefix
+    source = os.path.basename(arguments.idl)
+
+    outputs = {
+        name + ".h": generate_c_header(messages, arguments.prefix, source, name),
+        name + ".c": generate_c_source(messages, arguments.prefix, source, name),
+        name + ".hpp": generate_host(messages, arguments.prefix, source, name),
+    }
+
+    os.makedirs(arguments.output, exist_ok=True)
+
+    for file, content in outputs.items():
+        with open(os.path.join(arguments.output, file), "w") as target:
+            target.write(content)
+
+
+if __name__ == "__main__":
+    main()
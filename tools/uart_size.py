@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+@file uart_size.py
+@brief Flash size report of the size-optimized UART profile (uart_tiny.h).
+
+Builds a minimal echo program with avr-gcc twice, once with and once without the
+uart_tiny.h functions, and reports the difference of the program sizes (avr-size
+text + data), so startup code and vector table are not counted. The report fails
+(exit code 1) if the profile exceeds its flash budget.
+
+Usage: uart_size.py [--mcu MCU] [--f-cpu HZ] [--baudrate BAUD] [--budget BYTES] [--cc CC] [--size SIZE]
+
+@author g.raf
+@date 2026-10-18
+@version 1.0 Release
+@copyright
+Copyright (c) 2026 g.raf
+Released under the GPLv3 License. (see LICENSE in repository)
+
+@note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+
+@see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Every function is used once, the volatile keeps the baseline loop alive
+PROGRAM = """
+#include "uart_tiny.h"
+
+volatile unsigned char sink;
+
+int main(void)
+{
+#ifdef UART_TINY_SIZE
+    uart_tiny_init();
+
+    for (;;)
+    {
+        unsigned char data;
+
+        if (!uart_tiny_receive(&data))
+        {
+            uart_tiny_putchar(data);
+        }
+        sink = uart_tiny_getchar();
+    }
+#else
+    for (;;)
+    {
+        sink = 0;
+    }
+#endif
+}
+"""
+
+
+def build(args, directory, source, tiny):
+    output = os.path.join(directory, "tiny.elf" if tiny else "base.elf")
+    command = [
+        args.cc, "-mmcu=" + args.mcu, "-Os", "-std=gnu99",
+        "-DF_CPU=%dUL" % args.f_cpu, "-DUART_BAUDRATE=%dUL" % args.baudrate,
+        "-I", ROOT, "-o", output, source
+    ]
+    if tiny:
+        command.append("-DUART_TINY_SIZE")
+    subprocess.run(command, check=True)
+
+    result = subprocess.run([args.size, "--format=berkeley", output], check=True, stdout=subprocess.PIPE, universal_newlines=True)
+    fields = result.stdout.splitlines()[1].split()
+    return int(fields[0]) + int(fields[1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash size report of uart_tiny.h")
+    parser.add_argument("--mcu", default="atmega16")
+    parser.add_argument("--f-cpu", type=int, default=12000000)
+    parser.add_argument("--baudrate", type=int, default=9600)
+    parser.add_argument("--budget", type=int, default=60, help="flash budget in bytes (default 60)")
+    parser.add_argument("--cc", default="avr-gcc")
+    parser.add_argument("--size", default="avr-size")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        source = os.path.join(directory, "main.c")
+        with open(source, "w") as handle:
+            handle.write(PROGRAM)
+
+        try:
+            base = build(args, directory, source, False)
+            tiny = build(args, directory, source, True)
+        except (OSError, subprocess.CalledProcessError) as error:
+            sys.stderr.write("build failed: %s\n" % error)
+            return 2
+
+    used = tiny - base
+    print("%s, F_CPU %d, %d baud" % (args.mcu, args.f_cpu, args.baudrate))
+    print("  baseline   %5d bytes" % base)
+    print("  uart_tiny  %5d bytes" % tiny)
+    print("  profile    %5d bytes (budget %d)" % (used, args.budget))
+
+    if used > args.budget:
+        sys.stderr.write("uart_tiny exceeds its flash budget by %d bytes\n" % (used - args.budget))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -22,6 +22,42 @@
 
 #include "uart.h"
 
+#if UART_TX_BUFFER_SIZE > 0 || UART_RX_BUFFER_SIZE > 0 || UART_CALIBRATION > 0 || UART_CLOCK > 0
+    #include <avr/interrupt.h>
+    #include <avr/pgmspace.h>
+    #include <util/atomic.h>
+#elif !defined(UART_TXCIE) && !defined(UART_UDRIE)
+    #include <util/atomic.h>
+#endif
+
+#if UART_FRAME_CRC > 0
+    #include <util/crc16.h>
+#endif
+
+#if UART_RTOS > 0
+    #include "FreeRTOS.h"
+    #include "semphr.h"
+    #include "task.h"
+
+    #ifndef portYIELD_FROM_ISR
+        // Ports without portYIELD_FROM_ISR() switch context from an ISR with taskYIELD()
+        #define portYIELD_FROM_ISR() taskYIELD()
+    #endif
+#endif
+
+#if UART_CLOCK > 0
+    #ifndef CLKPR
+        #error "UART_CLOCK requires a device with system clock prescaler (CLKPR)"
+    #endif
+
+    // UBRR (bit 15 = U2X) for CLKPS 0-8, 0xFFFF = baud rate not reachable
+    static const uint16_t uart_clock_table[9] PROGMEM = {
+        UART_CLOCK_ENTRY(0), UART_CLOCK_ENTRY(1), UART_CLOCK_ENTRY(2),
+        UART_CLOCK_ENTRY(3), UART_CLOCK_ENTRY(4), UART_CLOCK_ENTRY(5),
+        UART_CLOCK_ENTRY(6), UART_CLOCK_ENTRY(7), UART_CLOCK_ENTRY(8)
+    };
+#endif
+
 #if UART_STDMODE > 0
     // Initialize FILE stream
     #if !defined(UART_TXCIE) && !defined(UART_UDRIE) && !defined(UART_RXCIE) && UART_STDMODE == 1
@@ -33,135 +69,2780 @@
     #endif
 #endif
 
-#if !defined(UART_RXCIE) && !defined(UART_TXCIE) && !defined(UART_UDRIE)
-    #if UART_HANDSHAKE > 0
-        static UART_Handshake uart_handshake_sending = UART_Ready;
-    #endif
-#endif
+#if !defined(UART_RXCIE) && !defined(UART_TXCIE) && !defined(UART_UDRIE)
+    #if UART_HANDSHAKE > 0
+        static volatile UART_Handshake uart_handshake_sending = UART_Ready;    // Remote state, UART_Pause after XOFF
+    #endif
+#endif
+
+#if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+    static volatile unsigned char uart_tx_sent;             // Set when a byte has been written to UDR since the last flush
+    static volatile unsigned char uart_tx_activity;         // Set when a byte has been written to UDR since the last uart_tx_active()
+
+    #define UART_TX_WHOLE 0x01      // Discard instead of truncate (messages that are useless in part, e.g. frames)
+    #define UART_TX_FRAME 0x02      // Byte of a frame that is written byte by byte (uart_frame_direct)
+
+    static char uart_tx_put(char data, unsigned char flags);
+#endif
+
+#if UART_TX_BUFFER_SIZE > 0
+    #define UART_TX_BUFFER_MASK (UART_TX_BUFFER_SIZE - 1)
+
+    static volatile char uart_tx_buffer[UART_TX_BUFFER_SIZE];
+    static volatile unsigned char uart_tx_reserve;          // Next index handed out to a producer
+    static volatile unsigned char uart_tx_commit;           // End of completely written data
+    static volatile unsigned char uart_tx_tail;             // Next index transmitted by the ISR
+    static volatile unsigned char uart_tx_writers;          // Producers between reservation and commit
+    static volatile unsigned char uart_tx_policy = UART_TX_OVERFLOW;
+    static volatile uint16_t uart_tx_discarded_count;
+
+    #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+        static volatile char uart_tx_control;               // XON/XOFF sent ahead of the queue, 0 = none
+    #endif
+
+    #if UART_DITHER > 0
+        static uint32_t uart_tx_dither;                     // Error accumulator of the fractional divider
+    #endif
+
+    #if UART_TX_PACING > 0
+        static volatile unsigned char uart_tx_tokens = UART_TX_PACING_BURST;
+        static volatile unsigned char uart_tx_gap;          // Remaining idle ticks after the last character
+        static uint16_t uart_tx_pacing;                     // Fractional token accumulator
+    #endif
+
+    #if UART_STREAM > 0
+        static unsigned char uart_stream_data[2][UART_STREAM_SIZE];
+        static volatile unsigned char uart_stream_length[2];    // Submitted bytes of a buffer, 0 = free
+        static volatile unsigned char uart_stream_half;         // Buffer on the wire
+        static volatile unsigned char uart_stream_index;        // Next byte of the buffer on the wire
+        static volatile unsigned char uart_stream_fill;         // Buffer the producer fills next
+        static volatile unsigned char uart_stream_active;
+        static volatile unsigned char uart_stream_starved;      // Underrun has been counted, cleared by a submit
+        static volatile uint16_t uart_stream_underrun_count;
+        static void (*uart_stream_producer)(void);
+    #endif
+#endif
+
+#if UART_RX_BUFFER_SIZE > 0
+    #define UART_RX_BUFFER_MASK (UART_RX_BUFFER_SIZE - 1)
+
+    static volatile char uart_rx_buffer[UART_RX_BUFFER_SIZE];
+    static volatile unsigned char uart_rx_head;             // Next index written by the ISR
+    static volatile unsigned char uart_rx_tail;             // Next index read by the application
+    static volatile unsigned char uart_rx_message;          // Start of the message currently received
+    static volatile unsigned char uart_rx_skip;             // Discard bytes up to the next delimiter
+    static volatile UART_Error uart_rx_error = UART_None;   // Latched receive error
+    static volatile unsigned char uart_rx_policy = UART_RX_OVERFLOW;
+    static volatile uint16_t uart_rx_discarded_count;
+
+    #if UART_HANDSHAKE > 0
+        static volatile unsigned char uart_rx_paused;       // Remote has been paused because of fill level
+    #endif
+
+    #if UART_RX_COALESCE > 0
+        static volatile unsigned char uart_rx_pending;      // Bytes received since the last signal
+        static volatile unsigned char uart_rx_idle;         // Ticks until the idle timeout signals
+        static volatile unsigned char uart_rx_signalled;    // Signal not yet taken by uart_rx_ready()
+        static void (*volatile uart_rx_callback)(void);
+    #endif
+#endif
+
+#if UART_RTOS > 0
+    static SemaphoreHandle_t uart_tx_semaphore;             // Counting, the transmit ISR gives once per blocked task
+    static volatile unsigned char uart_tx_waiting;          // Tasks registered for uart_tx_semaphore, cleared by the ISR that wakes them
+    static volatile unsigned char uart_tx_needed;           // Smallest free queue space of the registered tasks
+    static SemaphoreHandle_t uart_rx_semaphore;             // Counting, the receive ISR gives once per blocked task
+    static volatile unsigned char uart_rx_waiting;          // Tasks registered for uart_rx_semaphore, cleared by the ISR that wakes them
+    static SemaphoreHandle_t uart_stdio_mutex;              // Recursive, output lines and uart_lock()
+    static SemaphoreHandle_t uart_stdin_mutex;              // Recursive, input lines
+    static unsigned char uart_stdio_line;                   // uart_stdio_mutex is held for the current output line
+    static unsigned char uart_stdin_line;                   // uart_stdin_mutex is held for the current input line
+    static BaseType_t uart_rtos_woken;                      // An ISR has woken a task of higher priority
+
+    #if configSUPPORT_STATIC_ALLOCATION == 1
+        static StaticSemaphore_t uart_tx_semaphore_buffer;
+        static StaticSemaphore_t uart_rx_semaphore_buffer;
+        static StaticSemaphore_t uart_stdio_mutex_buffer;
+        static StaticSemaphore_t uart_stdin_mutex_buffer;
+    #endif
+#endif
+
+#if UART_EVENT > 0
+    static volatile unsigned char uart_event_types[UART_EVENT_QUEUE_SIZE];
+    static volatile uint16_t uart_event_counts[UART_EVENT_QUEUE_SIZE];
+    static volatile unsigned char uart_event_head;          // Next free entry
+    static volatile unsigned char uart_event_tail;          // Oldest unread entry
+    static volatile uint16_t uart_event_lost_count;
+    static void (*volatile uart_event_callback)(void);
+#endif
+
+#if UART_FRAME > 0
+    /**
+     * @brief Write state of a frame.
+     */
+    struct uart_frame_stream
+    {
+        uint16_t remaining;                                 // Payload bytes still expected
+        #if UART_FRAME_CRC > 0
+            uint16_t crc;
+        #endif
+        #if UART_TX_BUFFER_SIZE > 0
+            unsigned char index;                            // Next queue index of the reservation
+            unsigned char queued;                           // Frame is reserved as one message in the transmit queue
+        #endif
+        unsigned char open;
+        unsigned char fault;                                // Payload did not match the announced length
+    };
+
+    static struct uart_frame_stream uart_frame_active;      // Frame of uart_frame_begin()/uart_frame_end()
+    static volatile unsigned char uart_frame_direct;        // A frame is written byte by byte, other producers are held off
+
+    #if UART_FRAME_COALESCE > 0
+        static uint8_t uart_frame_pending[UART_FRAME_COALESCE_SIZE];
+        static volatile unsigned char uart_frame_fill;      // Payload bytes of the pending frame
+        static volatile unsigned char uart_frame_timer;     // Ticks until the pending frame is sent
+    #endif
+
+    #if UART_FRAME_RX > 0
+        static unsigned char uart_frame_rx_phase;           // 0 = length prefix, 1 = payload, 2 = CRC
+        static uint16_t uart_frame_rx_count;                // Bytes left in the current phase
+        static uint16_t uart_frame_rx_length;               // Length prefix of the current frame
+        static uint16_t uart_frame_rx_crc;
+        static unsigned char uart_frame_rx_write;           // Queue index of the next byte of the current frame
+        static unsigned char uart_frame_rx_drop;            // Current frame is discarded at its end
+        static volatile unsigned char uart_frame_rx_frames; // Complete frames in the receive queue
+        static volatile uint16_t uart_frame_rx_rejected;
+        static void (*volatile uart_frame_rx_callback)(void);
+
+        #if UART_FRAME_RX_TIMEOUT > 0
+            static volatile unsigned char uart_frame_rx_idle;   // Ticks until a partial frame is aborted
+        #endif
+    #endif
+#endif
+
+#if UART_MODE == 0
+    /**
+     * @brief Program the compile-time baud rate (UBRR and U2X).
+     */
+    static void uart_baudrate(void)
+    {
+        // Check which bit sampling mode should be activated
+        #if USE_2X
+            UCSRA |= (1<<U2X);          // Setup 8 samples/bit
+        #else
+            UCSRA &= ~(1<<U2X);         // Setup 16 samples/bit
+        #endif
+
+        #if UART_DITHER > 0
+            #if UART_DITHER_SAMPLES == 8
+                UCSRA |= (1<<U2X);
+            #else
+                UCSRA &= ~(1<<U2X);
+            #endif
+
+            UBRRH = (unsigned char)(UART_DITHER_UBRR >> 8);
+            UBRRL = (unsigned char)UART_DITHER_UBRR;
+        #else
+            UBRRH = UBRRH_VALUE;            // Calculated through setbaud.h
+            UBRRL = UBRRL_VALUE;            // Calculated through setbaud.h
+        #endif
+    }
+#endif
+
+#if UART_HANDOVER > 0
+    static UART_Handover uart_handover __attribute__((section(UART_HANDOVER_SECTION), used));
+
+    /**
+     * @brief Read and invalidate the handover record of the bootloader.
+     *
+     * @param[out] record Copy of the record.
+     * @return 1 if the record is valid and UBRR/U2X still hold its values, otherwise 0.
+     *
+     * @details
+     * Comparing against the registers rejects a record that survived a reset (e.g. watchdog) after which the USART is back in its reset state.
+     */
+    static unsigned char uart_handover_take(UART_Handover *record)
+    {
+        *record = uart_handover;
+        uart_handover.magic = 0;
+
+        // UBRRL first, UBRRH/UCSRC only returns UCSRC on a directly repeated read
+        uint16_t ubrr = UBRRL;
+
+        ubrr |= (uint16_t)(UBRRH & 0x0F) << 8;
+
+        return record->magic == UART_HANDOVER_MAGIC && record->ubrr == ubrr && (record->ucsra & (1<<U2X)) == (UCSRA & (1<<U2X)) && !(record->ucsrc & ((1<<URSEL) | (1<<UMSEL)));
+    }
+#endif
+
+/**
+ * @brief Initialize the UART hardware interface with configured parameters.
+ *
+ * @details
+ * This function configures the USART peripheral for polling-based operation:
+ * - Sets hardware handshake pins (RTS/CTS) if UART_HANDSHAKE==2
+ * - Calculates and applies baud rate using setbaud.h, or keeps the baud rate of the bootloader with UART_HANDOVER > 0
+ * - Configures frame format: data bits, parity, stop bits
+ * - Enables TX/RX with optional RXC echo and stdio stream assignment
+ *
+ * All configuration is derived from uart.h preprocessor macros.
+ *
+ * @note Call this function once during system initialization before using UART functions.
+ * @note stdio streams (stdout/stdin) are assigned only when UART_STDMODE > 0 and no interrupts defined.
+ */
+void uart_init(void)
+{
+    #if UART_MODE == 1
+        // Master SPI Mode, baud rate has to be 0 while the transmitter is enabled
+        UBRRH = 0;
+        UBRRL = 0;
+
+        UART_SPI_XCK_DDR |= (1<<UART_SPI_XCK_PIN);     // XCK output = SPI master
+
+        UCSRC = (1<<UMSEL1) | (1<<UMSEL0) | ((UART_SPI_ORDER & 0x01)<<UDORD) | ((UART_SPI_MODE & 0x01)<<UCPHA) | (((UART_SPI_MODE>>1) & 0x01)<<UCPOL);
+        UCSRB = (1<<RXEN) | (1<<TXEN);
+
+        UBRRH = (unsigned char)(UART_SPI_UBRR >> 8);    // SPI clock divider
+        UBRRL = (unsigned char)UART_SPI_UBRR;
+    #else
+        // Check if hardware flow control is enabled
+        #if UART_HANDSHAKE == 2
+            // Setup RTS (output)/CTS (input)
+            UART_HANDSHAKE_DDR |= (1<<UART_HANDSHAKE_RTS_PIN);
+            UART_HANDSHAKE_DDR &= ~(1<<UART_HANDSHAKE_CTS_PIN);
+        #endif
+    
+        unsigned char SETREG = (1<<URSEL);  // Activate URSEL (normally in register UCSRC)
+    
+        SETREG |= ((0x03 & (UART_DATASIZE - 5))<<UCSZ0);		// Setup data size
+    
+        #if UART_PARITY > 0
+            SETREG |= ((0x03 & (UART_PARITY + 1))<<UPM0);		// UART_Parity Mode
+        #endif
+    
+        #if UART_STOPBITS > 1
+            SETREG |= ((0x01 & (UART_STOPBITS - 1))<<USBS);     // Setup stop bits
+        #endif
+
+        #if UART_HANDOVER > 0
+            UART_Handover handover;
+
+            // A reprogrammed UBRR would force the peer to renegotiate the link
+            if (uart_handover_take(&handover))
+            {
+                SETREG = (1<<URSEL) | handover.ucsrc;
+            }
+            else
+            {
+                uart_baudrate();
+            }
+        #else
+            uart_baudrate();
+        #endif
+
+        #if UART_DITHER > 0
+            uart_tx_dither = 0;
+        #endif
+    
+        #if UART_TX_BUFFER_SIZE > 0
+            uart_tx_reserve = 0;
+            uart_tx_commit = 0;
+            uart_tx_tail = 0;
+            uart_tx_writers = 0;
+
+            #if UART_STREAM > 0
+                uart_stream_active = 0;
+            #endif
+        #endif
+
+        #if UART_RX_BUFFER_SIZE > 0
+            uart_rx_head = 0;
+            uart_rx_tail = 0;
+            uart_rx_message = 0;
+            uart_rx_skip = 0;
+            uart_rx_error = UART_None;
+
+            #if UART_RX_COALESCE > 0
+                uart_rx_pending = 0;
+                uart_rx_idle = 0;
+                uart_rx_signalled = 0;
+            #endif
+        #endif
+
+        #if UART_EVENT > 0
+            uart_event_head = 0;
+            uart_event_tail = 0;
+        #endif
+
+        #if UART_RTOS > 0
+            // Created once, uart_init() may be called again to reconfigure
+            if (!uart_tx_semaphore)
+            {
+                #if configSUPPORT_STATIC_ALLOCATION == 1
+                    uart_tx_semaphore = xSemaphoreCreateCountingStatic(255, 0, &uart_tx_semaphore_buffer);
+                    uart_rx_semaphore = xSemaphoreCreateCountingStatic(255, 0, &uart_rx_semaphore_buffer);
+                    uart_stdio_mutex = xSemaphoreCreateRecursiveMutexStatic(&uart_stdio_mutex_buffer);
+                    uart_stdin_mutex = xSemaphoreCreateRecursiveMutexStatic(&uart_stdin_mutex_buffer);
+                #else
+                    uart_tx_semaphore = xSemaphoreCreateCounting(255, 0);
+                    uart_rx_semaphore = xSemaphoreCreateCounting(255, 0);
+                    uart_stdio_mutex = xSemaphoreCreateRecursiveMutex();
+                    uart_stdin_mutex = xSemaphoreCreateRecursiveMutex();
+                #endif
+            }
+
+            uart_tx_waiting = 0;
+            uart_tx_needed = 0;
+            uart_rx_waiting = 0;
+        #endif
+
+        #if UART_FRAME > 0
+            uart_frame_active.open = 0;
+            uart_frame_direct = 0;
+
+            #if UART_FRAME_COALESCE > 0
+                uart_frame_fill = 0;
+                uart_frame_timer = 0;
+            #endif
+
+            #if UART_FRAME_RX > 0
+                uart_frame_rx_phase = 0;
+                uart_frame_rx_count = UART_FRAME_LENGTH_BYTES;
+                uart_frame_rx_length = 0;
+                uart_frame_rx_crc = 0;
+                uart_frame_rx_drop = 0;
+                uart_frame_rx_frames = 0;
+            #endif
+        #endif
+
+        #if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+            uart_tx_sent = 0;
+        #endif
+
+        UCSRC = SETREG;                 // Write SETREG settings to UCSRC
+        UCSRB = (1<<RXEN) | (1<<TXEN);  // Activate UART transmitter and receiver
+
+        // Interrupt control
+    
+        // Receiver interrupt setup
+        #if defined(UART_RXCIE) || UART_RX_BUFFER_SIZE > 0
+            UCSRB |= (1<<RXCIE);
+        #endif
+
+        // Transmitter interrupt setup
+        #if defined(UART_TXCIE) && !defined(UART_UDRIE)
+            UCSRB |= (1<<TXCIE);
+        #endif
+
+        // Transmitter interrupt setup
+        #if !defined(UART_TXCIE) && defined(UART_UDRIE)
+            UCSRB |= (1<<UDRIE);
+        #endif
+
+        #if !defined(UART_TXCIE) && !defined(UART_UDRIE) && (UART_STDMODE == 1 || UART_STDMODE == 2)
+            stdout = &std_uart;
+        #endif
+    
+        #if !defined(UART_RXCIE) && UART_STDMODE == 1 || UART_STDMODE == 3
+            stdin = &std_uart;
+        #endif
+    #endif
+}
+
+/**
+ * @brief Disable the UART hardware interface and reset configuration.
+ *
+ * @details
+ * This function completely disables the USART peripheral by clearing TXEN/RXEN bits and all interrupt enables. Call before reconfiguring UART or entering power-save modes.
+ */
+void uart_disable(void)
+{
+    
+    UCSRB &= ~((1<<RXEN) | (1<<TXEN));
+	UCSRB &= ~((1<<RXCIE) | (1<<TXCIE) | (1<<UDRIE));
+	UCSRA |= (1<<TXC);
+	
+	#if !defined(UART_TXCIE) && !defined(UART_UDRIE) && (UART_STDMODE == 1 || UART_STDMODE == 2)
+		stdout = NULL;
+	#endif
+	
+	#if !defined(UART_RXCIE) && UART_STDMODE == 1 || UART_STDMODE == 3
+		stdin = NULL;
+	#endif
+	
+	#if UART_HANDSHAKE == 2
+		UART_HANDSHAKE_DDR &= ~((1<<UART_HANDSHAKE_RTS_PIN) | (1<<UART_HANDSHAKE_CTS_PIN));
+	#endif
+}
+
+#if UART_CALIBRATION > 0
+    static uint16_t uart_calibration_last;          // Timer1 value of the last timeout check
+    static unsigned char uart_calibration_overflows;    // Remaining Timer1 overflows of the measurement
+
+    /**
+     * @brief Count Timer1 wrap-arounds of a measurement.
+     *
+     * @return 1 if UART_CALIBRATION_TIMEOUT overflows have passed.
+     *
+     * @details
+     * The wrap-around is detected from the counter value instead of TOV1, so an overflow flag of the application stays untouched. The polling loops are much shorter than 65536 cycles, no wrap-around is missed.
+     */
+    static inline unsigned char uart_calibration_expired(void)
+    {
+        uint16_t now = TCNT1;
+        unsigned char wrapped = (now < uart_calibration_last);
+
+        uart_calibration_last = now;
+        return wrapped && !--uart_calibration_overflows;
+    }
+
+    /**
+     * @brief Measure 8 bit times of a received 0x55 stream.
+     *
+     * @return Duration in CPU cycles, 0 on timeout.
+     *
+     * @details
+     * Runs with interrupts disabled so the edge detection loop is not delayed. Timer1 has to run at clk/1. The received character is removed from UDR afterwards.
+     */
+    static uint16_t uart_calibration_measure(void)
+    {
+        unsigned char edges = 5;
+        uint16_t start = 0;
+
+        uart_calibration_overflows = UART_CALIBRATION_TIMEOUT;
+        uart_calibration_last = TCNT1;
+
+        while (edges)
+        {
+            // Wait for high level
+            while (!(UART_CALIBRATION_PIN & (1<<UART_CALIBRATION_RXD)))
+            {
+                if (uart_calibration_expired())
+                {
+                    return 0;
+                }
+            }
+
+            // Wait for falling edge
+            while ((UART_CALIBRATION_PIN & (1<<UART_CALIBRATION_RXD)))
+            {
+                if (uart_calibration_expired())
+                {
+                    return 0;
+                }
+            }
+
+            if (edges-- == 5)
+            {
+                start = TCNT1;
+            }
+        }
+
+        uint16_t ticks = TCNT1 - start;
+
+        // Discard the sync character
+        while (!(UCSRA & (1<<RXC)))
+        {
+            if (uart_calibration_expired())
+            {
+                break;
+            }
+        }
+        UDR;
+
+        return ticks;
+    }
+
+    /**
+     * @brief Average the bit time measurement over UART_CALIBRATION_SAMPLES sync characters.
+     *
+     * @return Average duration of 8 bits in CPU cycles, 0 on timeout.
+     */
+    static uint16_t uart_calibration_average(void)
+    {
+        uint32_t sum = 0;
+
+        for (unsigned char sample = 0; sample < UART_CALIBRATION_SAMPLES; sample++)
+        {
+            uint16_t ticks;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                ticks = uart_calibration_measure();
+            }
+
+            if (!ticks)
+            {
+                return 0;
+            }
+            sum += ticks;
+        }
+        return (uint16_t)(sum / UART_CALIBRATION_SAMPLES);
+    }
+
+    /**
+     * @brief Calibrate the link against received sync characters (0x55).
+     *
+     * @return 0 if calibrated, 1 if no sync characters have been received or the clock could not be trimmed into UART_CALIBRATION_TOLERANCE.
+     *
+     * @details
+     * The remote has to send a continuous stream of 0x55 while this function runs. Each measurement averages UART_CALIBRATION_SAMPLES characters:
+     * - UART_CALIBRATION == 1: OSCCAL is stepped towards the expected bit time, the step size is halved on every overshoot. F_CPU and all derived timings are valid afterwards.
+     * - UART_CALIBRATION == 2: UBRR is recalculated from the measured bit time, the CPU clock stays untouched.
+     *
+     * Timer1 (TCCR1A, TCCR1B, TCNT1) is restored afterwards, TCNT1 continues from its value at the call. A TOV1 caused by the calibration is cleared, a TOV1 that was already pending stays set.
+     *
+     * @note Can be called at any time (e.g. periodically on a sync request of the host) to follow temperature drift.
+     *
+     * @attention Interrupts are disabled during each measurement. Without sync characters the worst-case interrupt latency is UART_CALIBRATION_TIMEOUT * 65536 CPU cycles (about 262 ms at 16 MHz with the default 64). Lower UART_CALIBRATION_TIMEOUT if other interrupts have deadlines.
+     */
+    char uart_calibrate(void)
+    {
+        unsigned char tccr1a = TCCR1A;
+        unsigned char tccr1b = TCCR1B;
+        unsigned char pending = TIFR & (1<<TOV1);
+        uint16_t tcnt1;
+        char result = 1;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            tcnt1 = TCNT1;          // 16 bit access uses the shared TEMP register
+        }
+
+        TCCR1A = 0;
+        TCCR1B = (1<<CS10);         // Timer1 at clk/1
+
+        #if UART_CALIBRATION == 1
+            unsigned char step = 8;
+            signed char direction = 0;
+
+            for (unsigned char iteration = 0; iteration < UART_CALIBRATION_ITERATIONS; iteration++)
+            {
+                uint16_t ticks = uart_calibration_average();
+
+                if (!ticks)
+                {
+                    break;
+                }
+
+                if (ticks > (UART_CALIBRATION_TICKS - UART_CALIBRATION_TOLERANCE) && ticks < (UART_CALIBRATION_TICKS + UART_CALIBRATION_TOLERANCE))
+                {
+                    result = 0;
+                    break;
+                }
+
+                // More ticks than expected = clock too fast
+                signed char next = (ticks > UART_CALIBRATION_TICKS) ? -1 : 1;
+
+                // Overshoot, continue with finer steps
+                if (direction && next != direction && step > 1)
+                {
+                    step >>= 1;
+                }
+                direction = next;
+
+                if (next < 0)
+                {
+                    OSCCAL = (OSCCAL > step) ? (OSCCAL - step) : 0;
+                }
+                else
+                {
+                    OSCCAL = (OSCCAL < (0xFF - step)) ? (OSCCAL + step) : 0xFF;
+                }
+            }
+        #else
+            uint16_t ticks = uart_calibration_average();
+
+            if (ticks)
+            {
+                // Bit time = ticks/8, UBRR = bit time/16 - 1 (bit time/8 - 1 with U2X)
+                uint16_t ubrr;
+
+                if (UCSRA & (1<<U2X))
+                {
+                    ubrr = ((ticks + 32) >> 6) - 1;
+                }
+                else
+                {
+                    ubrr = ((ticks + 64) >> 7) - 1;
+                }
+
+                UBRRH = (unsigned char)(ubrr >> 8) & 0x0F;
+                UBRRL = (unsigned char)ubrr;
+                result = 0;
+            }
+        #endif
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            TCCR1B = 0;             // Stop Timer1 while its state is restored
+            TCNT1 = tcnt1;
+
+            if (!pending)
+            {
+                TIFR = (1<<TOV1);   // Written one clears the flag
+            }
+
+            TCCR1A = tccr1a;
+            TCCR1B = tccr1b;
+        }
+
+        return result;
+    }
+#endif
+
+#if UART_CLOCK > 0
+    /**
+     * @brief Change the system clock prescaler without losing the UART link.
+     *
+     * @param prescaler CLKPS value 0-8 (system clock = F_CPU / 2^prescaler).
+     * @return 0 if the clock has been changed, 1 if the baud rate is not reachable with this prescaler (clock unchanged).
+     *
+     * @details
+     * Drains the transmitter, pauses the remote (UART_HANDSHAKE > 0), writes the timed CLKPR sequence and UBRR/U2X from the precalculated table in one critical section and resumes the remote.
+     *
+     * @note Use this function instead of writing CLKPR directly. Timings based on F_CPU (e.g. _delay_ms()) are scaled by the prescaler.
+     */
+    char uart_clock(unsigned char prescaler)
+    {
+        if (prescaler > 8)
+        {
+            return 1;
+        }
+
+        uint16_t entry = pgm_read_word(&uart_clock_table[prescaler]);
+
+        if (entry == 0xFFFF)
+        {
+            return 1;
+        }
+
+        #if UART_HANDSHAKE > 0 && !defined(UART_TXCIE) && !defined(UART_UDRIE) && !defined(UART_RXCIE)
+            uart_handshake(UART_Pause);
+        #endif
+
+        #if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+            uart_flush();
+        #else
+            while (!(UCSRA & (1<<UDRE)));
+        #endif
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            CLKPR = (1<<CLKPCE);        // Timed sequence, CLKPS has to be written within 4 cycles
+            CLKPR = prescaler;
+
+            if (entry & 0x8000)
+            {
+                UCSRA |= (1<<U2X);
+            }
+            else
+            {
+                UCSRA &= ~(1<<U2X);
+            }
+
+            UBRRH = (unsigned char)(entry >> 8) & 0x0F;
+            UBRRL = (unsigned char)entry;
+        }
+
+        #if UART_HANDSHAKE > 0 && !defined(UART_TXCIE) && !defined(UART_UDRIE) && !defined(UART_RXCIE)
+            uart_handshake(UART_Ready);
+        #endif
+
+        return 0;
+    }
+#endif
+
+#if UART_MODE == 1
+    /**
+     * @brief Exchange a single byte in Master SPI Mode.
+     *
+     * @param data Byte to transmit (MOSI).
+     * @return Byte received at the same time (MISO).
+     *
+     * @note Chip select has to be handled by the application.
+     */
+    uint8_t uart_spi_exchange(uint8_t data)
+    {
+        while (!(UCSRA & (1<<UDRE)));
+        UDR = data;
+
+        while (!(UCSRA & (1<<RXC)));
+        return UDR;
+    }
+
+    /**
+     * @brief Transfer a block in Master SPI Mode without gap between the bytes.
+     *
+     * @param transmit Bytes to transmit or NULL to transmit 0xFF (e.g. reading from flash memory).
+     * @param receive Buffer for the received bytes or NULL to discard them (e.g. writing to a display).
+     * @param length Number of bytes.
+     *
+     * @details
+     * The transmit buffer is refilled as soon as UDRE signals space, while the previous byte is still shifted out, so SCK runs continuously. At most two bytes are in flight, which matches the two level receive FIFO and prevents receive overruns.
+     */
+    void uart_spi_transfer(const uint8_t *transmit, uint8_t *receive, uint16_t length)
+    {
+        uint16_t sent = 0;
+        uint16_t received = 0;
+
+        while (received < length)
+        {
+            if (sent < length && (unsigned char)(sent - received) < 2 && (UCSRA & (1<<UDRE)))
+            {
+                UDR = transmit ? transmit[sent] : 0xFF;
+                sent++;
+            }
+
+            if (UCSRA & (1<<RXC))
+            {
+                uint8_t data = UDR;
+
+                if (receive)
+                {
+                    receive[received] = data;
+                }
+                received++;
+            }
+        }
+    }
+#endif
+
+#if UART_RTOS > 0
+    /**
+     * @brief Check if blocking on a semaphore is possible.
+     *
+     * @param enabled Global interrupt flag of the caller.
+     * @return 1 if the scheduler is running and the caller is not an ISR/critical section.
+     */
+    static inline unsigned char uart_rtos_blocking(unsigned char enabled)
+    {
+        return enabled && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    }
+
+    /**
+     * @brief Wake all tasks registered for a semaphore.
+     *
+     * @param semaphore Counting semaphore the tasks block on.
+     * @param[in,out] waiting Registered tasks, incremented by a task in the critical section that found its condition false and cleared here.
+     *
+     * @details
+     * Called from the UART ISRs. One give per registered task, every task rechecks its own condition and registers again if it still has to wait. A single give would leave the other tasks blocked, e.g. two tasks in uart_flush() when the last UDRE interrupt of the queue switches UDRIE off.
+     */
+    static inline void uart_rtos_wake(SemaphoreHandle_t semaphore, volatile unsigned char *waiting)
+    {
+        while (*waiting)
+        {
+            (*waiting)--;
+            xSemaphoreGiveFromISR(semaphore, &uart_rtos_woken);
+        }
+    }
+
+    /**
+     * @brief Switch to a task woken during the ISR.
+     *
+     * @details
+     * Called at the end of the UART ISRs.
+     */
+    static inline void uart_rtos_yield(void)
+    {
+        if (uart_rtos_woken != pdFALSE)
+        {
+            uart_rtos_woken = pdFALSE;
+            portYIELD_FROM_ISR();
+        }
+    }
+
+    #if UART_STDMODE > 0
+        /**
+         * @brief Take a stdio mutex at the start of a line.
+         *
+         * @param mutex Recursive mutex of the stream direction.
+         * @param[in,out] line Set if the mutex has been taken for the line.
+         * @return 1 if the calling task holds the mutex for the current line, 0 otherwise.
+         *
+         * @details
+         * Nothing is taken if the calling task already holds the mutex, e.g. with uart_lock() or for the rest of a line. Callers that cannot block (ISRs, interrupts disabled, scheduler not running) neither take the mutex nor own the line of another task.
+         */
+        static char uart_stdio_begin(SemaphoreHandle_t mutex, unsigned char *line)
+        {
+            if (!uart_rtos_blocking(SREG & (1<<SREG_I)))
+            {
+                return 0;
+            }
+
+            if (xSemaphoreGetMutexHolder(mutex) != xTaskGetCurrentTaskHandle())
+            {
+                xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+                *line = 1;
+            }
+            return *line;
+        }
+
+        /**
+         * @brief Release a stdio mutex at the end of a line.
+         *
+         * @param mutex Recursive mutex of the stream direction.
+         * @param[in,out] line Set if the mutex has been taken for the line.
+         * @param owner Result of uart_stdio_begin().
+         * @param data Character that has just been transferred.
+         */
+        static void uart_stdio_end(SemaphoreHandle_t mutex, unsigned char *line, char owner, char data)
+        {
+            if (owner && data == '\n')
+            {
+                *line = 0;
+                xSemaphoreGiveRecursive(mutex);
+            }
+        }
+    #endif
+
+    /**
+     * @brief Take the stdio mutex.
+     *
+     * @details
+     * The stdout stream takes the mutex for every line by itself, uart_lock() groups several lines (e.g. a table) against interleaving with the output of other tasks. Calls may be nested. Before the scheduler is started the call does nothing.
+     */
+    void uart_lock(void)
+    {
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+        {
+            xSemaphoreTakeRecursive(uart_stdio_mutex, portMAX_DELAY);
+        }
+    }
+
+    /**
+     * @brief Release the stdio mutex taken with uart_lock().
+     */
+    void uart_unlock(void)
+    {
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+        {
+            xSemaphoreGiveRecursive(uart_stdio_mutex);
+        }
+    }
+#endif
+
+#if UART_EVENT > 0
+    /**
+     * @brief Queue an event or coalesce it into the unread event of the same type.
+     *
+     * @param type Event type.
+     * @param count Number of occurrences.
+     *
+     * @details
+     * Called with interrupts disabled (ISRs and critical sections of the driver). The callback of uart_event_notify() is only called for a newly queued event.
+     */
+    static void uart_event_post(unsigned char type, uint16_t count)
+    {
+        unsigned char index = uart_event_tail;
+
+        while (index != uart_event_head)
+        {
+            if (uart_event_types[index] == type)
+            {
+                uint16_t sum = uart_event_counts[index] + count;
+
+                // Saturate instead of wrapping around
+                uart_event_counts[index] = (sum < count) ? 0xFFFF : sum;
+                return;
+            }
+
+            if (++index >= UART_EVENT_QUEUE_SIZE)
+            {
+                index = 0;
+            }
+        }
+
+        unsigned char next = (index + 1 < UART_EVENT_QUEUE_SIZE) ? (index + 1) : 0;
+
+        if (next == uart_event_tail)
+        {
+            uart_event_lost_count++;
+            return;
+        }
+
+        uart_event_types[index] = type;
+        uart_event_counts[index] = count;
+        uart_event_head = next;
+
+        void (*callback)(void) = uart_event_callback;
+
+        if (callback)
+        {
+            callback();
+        }
+    }
+
+    /**
+     * @brief Take the oldest unread event.
+     *
+     * @param[out] event Event type and number of coalesced occurrences.
+     * @return 1 if an event has been taken, 0 if the queue is empty.
+     *
+     * @code
+     * UART_Event event;
+     *
+     * while (uart_event_read(&event))
+     * {
+     *     if (event.type == UART_EVENT_OVERRUN)
+     *     {
+     *         overruns += event.count;
+     *     }
+     * }
+     * @endcode
+     */
+    unsigned char uart_event_read(UART_Event *event)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            unsigned char tail = uart_event_tail;
+
+            if (tail == uart_event_head)
+            {
+                return 0;
+            }
+
+            event->type = uart_event_types[tail];
+            event->count = uart_event_counts[tail];
+            uart_event_tail = (tail + 1 < UART_EVENT_QUEUE_SIZE) ? (tail + 1) : 0;
+        }
+        return 1;
+    }
+
+    /**
+     * @brief Register a callback for new events.
+     *
+     * @param callback Function called from the ISR (or the critical section of a producer) when an event is queued, NULL to disable.
+     *
+     * @note Coalesced occurrences do not call the callback again. Keep it short, e.g. set a flag or wake a task.
+     */
+    void uart_event_notify(void (*callback)(void))
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            uart_event_callback = callback;
+        }
+    }
+
+    /**
+     * @brief Read and reset the number of lost events.
+     *
+     * @return Number of events that found the queue full since the last call.
+     */
+    uint16_t uart_event_lost(void)
+    {
+        uint16_t count;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            count = uart_event_lost_count;
+            uart_event_lost_count = 0;
+        }
+        return count;
+    }
+#endif
+
+#if UART_TX_BUFFER_SIZE > 0
+    /**
+     * @brief Count discarded transmit bytes.
+     *
+     * @param count Number of discarded bytes.
+     *
+     * @details
+     * Called with interrupts disabled.
+     */
+    static inline void uart_tx_discard(unsigned char count)
+    {
+        uart_tx_discarded_count += count;
+
+        #if UART_EVENT > 0
+            uart_event_post(UART_EVENT_TX_OVERFLOW, 1);
+        #endif
+    }
+
+    #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+        // Remote sent XOFF, XON restarts the queue
+        #define UART_TX_REMOTE_PAUSED() (uart_handshake_sending != UART_Ready)
+    #elif UART_HANDSHAKE == 2
+        // CTS inactive (high), the next commit or uart_tick() restarts the queue
+        #define UART_TX_REMOTE_PAUSED() (UART_HANDSHAKE_PIN & (1<<UART_HANDSHAKE_CTS_PIN))
+    #else
+        #define UART_TX_REMOTE_PAUSED() 0
+    #endif
+
+    #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+        /**
+         * @brief Transmit a pending XON/XOFF ahead of the transmit queue.
+         *
+         * @return 1 if UDR has been written, 0 if no control character is pending.
+         *
+         * @details
+         * Called when UDR is empty, by ISR(UART_UDRE_vect) and by uart_tx_next(). A paused remote does not stop the control character, the local receiver has to be able to pause the remote at any time.
+         */
+        static inline unsigned char uart_tx_control_next(void)
+        {
+            char data = uart_tx_control;
+
+            if (!data)
+            {
+                return 0;
+            }
+            uart_tx_control = 0;
+
+            UCSRA |= (1<<TXC);      // Clear transmit complete flag
+            UDR = data;
+            uart_tx_sent = 1;
+            uart_tx_activity = 1;
+
+            #if UART_DITHER > 0
+                // Same as a queued character, the transmit complete ISR restarts the queue
+                UCSRB = (UCSRB & ~(1<<UDRIE)) | (1<<TXCIE);
+            #endif
+            return 1;
+        }
+
+        /**
+         * @brief Send XON/XOFF ahead of the transmit queue.
+         *
+         * @param data UART_HANDSHAKE_XON or UART_HANDSHAKE_XOFF.
+         *
+         * @details
+         * Writes UDR directly if it is empty. Otherwise the character waits in a one byte slot that the UDRE interrupt sends before the next queued byte, a newer state replaces a pending one. Never blocks, safe in ISR context.
+         */
+        static void uart_tx_control_send(char data)
+        {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_tx_control = data;
+
+                #if UART_DITHER > 0
+                    if (UCSRB & (1<<TXCIE))
+                    {
+                        return;     // Character in the shift register, the transmit complete ISR restarts
+                    }
+                #endif
+
+                if (UCSRA & (1<<UDRE))
+                {
+                    uart_tx_control_next();
+                }
+                else
+                {
+                    UCSRB |= (1<<UDRIE);
+                }
+            }
+        }
+    #endif
+
+    /**
+     * @brief Transmit the next committed byte of the transmit queue.
+     *
+     * @details
+     * Shared by ISR(UART_UDRE_vect) and the producers, which call it when the queue is full while interrupts are disabled (e.g. logging from another ISR). Clears TXC so uart_flush() can detect the end of transmission. A pending XON/XOFF goes first. Disables UDRIE as soon as no committed data is left or the remote paused the transmission (UART_HANDSHAKE).
+     */
+    static inline void uart_tx_next(void)
+    {
+        unsigned char tail = uart_tx_tail;
+
+        #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+            if (uart_tx_control_next())
+            {
+                return;
+            }
+        #endif
+
+        if (UART_TX_REMOTE_PAUSED())
+        {
+            UCSRB &= ~(1<<UDRIE);
+            return;
+        }
+
+        #if UART_TX_PACING > 0
+            if (!uart_tx_tokens || uart_tx_gap)
+            {
+                UCSRB &= ~(1<<UDRIE);   // Bucket empty, uart_tick() restarts the queue
+                return;
+            }
+        #endif
+
+        if (tail != uart_tx_commit)
+        {
+            #if UART_TX_PACING > 0
+                uart_tx_tokens--;
+                uart_tx_gap = UART_TX_PACING_GAP;
+            #endif
+
+            UCSRA |= (1<<TXC);      // Clear transmit complete flag
+            UDR = uart_tx_buffer[tail];
+            uart_tx_sent = 1;
+            uart_tx_activity = 1;
+
+            tail = (tail + 1) & UART_TX_BUFFER_MASK;
+            uart_tx_tail = tail;
+
+            #if UART_RTOS > 0
+                // Wake all blocked producers when the smallest space is free and uart_flush() when the queue is empty
+                if (uart_tx_waiting && (tail == uart_tx_commit || ((tail - uart_tx_reserve - 1) & UART_TX_BUFFER_MASK) >= uart_tx_needed))
+                {
+                    uart_rtos_wake(uart_tx_semaphore, &uart_tx_waiting);
+                }
+            #endif
+
+            #if UART_DITHER > 0
+                // One character at a time, next UBRR is applied when the line is idle
+                UCSRB = (UCSRB & ~(1<<UDRIE)) | (1<<TXCIE);
+                return;
+            #endif
+        }
+
+        if (tail == uart_tx_commit)
+        {
+            UCSRB &= ~(1<<UDRIE);   // Nothing left, stop interrupt until next commit
+        }
+    }
+
+    /**
+     * @brief Enable the Data Register Empty interrupt after a commit.
+     *
+     * @details
+     * While dithering, a character in the shift register must complete before the next UBRR is applied, the transmit complete ISR restarts the queue then. While pacing, uart_tick() restarts the queue when tokens are available.
+     */
+    static inline void uart_tx_start(void)
+    {
+        #if UART_DITHER > 0
+            if (UCSRB & (1<<TXCIE))
+            {
+                return;
+            }
+        #endif
+
+        #if UART_TX_PACING > 0
+            if (!uart_tx_tokens || uart_tx_gap)
+            {
+                return;
+            }
+        #endif
+
+        UCSRB |= (1<<UDRIE);
+    }
+
+    #if UART_HANDSHAKE == 2
+        /**
+         * @brief Restart the transmit queue when CTS became active again.
+         *
+         * @details
+         * CTS has no interrupt, the waiting loops, uart_tick() and every commit call this function with interrupts disabled.
+         */
+        static inline void uart_tx_resume(void)
+        {
+            if (uart_tx_tail != uart_tx_commit && !UART_TX_REMOTE_PAUSED())
+            {
+                uart_tx_start();
+            }
+        }
+    #endif
+
+    #if UART_STREAM > 0
+        /**
+         * @brief Transmit the next byte of the stream.
+         *
+         * @details
+         * Called from ISR(UART_UDRE_vect) only. A transmitted buffer is freed and the producer is called, the other buffer continues without a gap if it has been submitted. Otherwise UDRIE is disabled until the next submit.
+         */
+        static inline void uart_stream_next(void)
+        {
+            unsigned char half = uart_stream_half;
+
+            if (!uart_stream_length[half])
+            {
+                if (!uart_stream_starved)
+                {
+                    uart_stream_starved = 1;
+                    uart_stream_underrun_count++;
+                }
+
+                UCSRB &= ~(1<<UDRIE);
+                return;
+            }
+
+            UCSRA |= (1<<TXC);      // Clear transmit complete flag
+            UDR = uart_stream_data[half][uart_stream_index++];
+            uart_tx_sent = 1;
+            uart_tx_activity = 1;
+
+            if (uart_stream_index >= uart_stream_length[half])
+            {
+                uart_stream_length[half] = 0;
+                uart_stream_index = 0;
+                uart_stream_half = half ^ 1;
+
+                if (uart_stream_producer)
+                {
+                    uart_stream_producer();
+                }
+            }
+        }
+    #endif
+
+    /**
+     * @brief Data Register Empty interrupt, drains the transmit queue.
+     */
+    ISR(UART_UDRE_vect)
+    {
+        #if UART_STREAM > 0
+            #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+                if (uart_tx_control_next())
+                {
+                    return;
+                }
+            #endif
+
+            if (uart_stream_active)
+            {
+                uart_stream_next();
+                return;
+            }
+        #endif
+
+        uart_tx_next();
+
+        #if UART_RTOS > 0
+            uart_rtos_yield();
+        #endif
+    }
+
+    #if UART_DITHER > 0
+        /**
+         * @brief Select the UBRR of the next character (line idle).
+         *
+         * @details
+         * Bresenham accumulator: UART_DITHER_FRACTION out of UART_DITHER_DENOMINATOR characters are sent with the upper UBRR. UBRRH has to be written before UBRRL, which updates the prescaler immediately.
+         */
+        static inline void uart_tx_dither_next(void)
+        {
+            uint16_t ubrr = UART_DITHER_UBRR;
+
+            uart_tx_dither += UART_DITHER_FRACTION;
+
+            if (uart_tx_dither >= UART_DITHER_DENOMINATOR)
+            {
+                uart_tx_dither -= UART_DITHER_DENOMINATOR;
+                ubrr++;
+            }
+
+            UBRRH = (unsigned char)(ubrr >> 8);
+            UBRRL = (unsigned char)ubrr;
+        }
+
+        /**
+         * @brief Transmit Complete interrupt, applies the dithered UBRR and restarts the queue.
+         */
+        ISR(UART_TXC_vect)
+        {
+            UCSRB &= ~(1<<TXCIE);
+            uart_tx_dither_next();
+
+            #if UART_HANDSHAKE == 1 && !defined(UART_RXCIE)
+                if (uart_tx_tail != uart_tx_commit || uart_tx_control)
+            #else
+                if (uart_tx_tail != uart_tx_commit)
+            #endif
+            {
+                UCSRB |= (1<<UDRIE);
+            }
+        }
+    #endif
+
+    /**
+     * @brief Reserve space for a message in the transmit queue.
+     *
+     * @param length Number of bytes to reserve.
+     * @param[out] start Queue index of the first reserved byte.
+     * @param flags UART_TX_WHOLE, UART_TX_FRAME or 0.
+     * @param policy Overflow policy of this reservation, usually uart_tx_policy.
+     * @return Number of reserved bytes (less than length if truncated, 0 if discarded).
+     *
+     * @details
+     * The reservation itself is a short critical section. If the queue is full, the overflow policy decides:
+     * - UART_OVERFLOW_BLOCK: If interrupts are enabled, the function waits for the ISR. If interrupts are disabled, the queue is drained by polling UDRE instead, which avoids the UDRE deadlock of nested producers. A producer that runs with interrupts disabled and only finds uncommitted data in front of it (the interrupted producer is still copying) or a running stream (UART_STREAM) cannot make progress and its message is discarded.
+     * - UART_OVERFLOW_DROP_NEWEST: The message is truncated to the free space.
+     * - UART_OVERFLOW_DROP_OLDEST: Committed but not yet transmitted bytes are discarded to make room, then the message is truncated if still necessary.
+     * - UART_OVERFLOW_DROP_MESSAGE: The message is discarded.
+     *
+     * A whole reservation is never truncated, it is discarded instead. While a frame larger than the transmit queue is written byte by byte, the messages of other producers would end up inside the frame. They are discarded, a blocking RTOS task waits for the end of the frame instead. All discarded bytes are counted (see uart_tx_discarded()).
+     */
+    static unsigned char uart_tx_reserve_space(unsigned char length, unsigned char *start, unsigned char flags, unsigned char policy)
+    {
+        for (;;)
+        {
+            #if UART_RTOS > 0
+                unsigned char blocking = uart_rtos_blocking(SREG & (1<<SREG_I));
+            #endif
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                unsigned char reserve = uart_tx_reserve;
+                unsigned char space = (uart_tx_tail - reserve - 1) & UART_TX_BUFFER_MASK;
+
+                #if UART_FRAME > 0
+                    if (uart_frame_direct && !(flags & UART_TX_FRAME))
+                    {
+                        #if UART_RTOS > 0
+                            if (!blocking || policy != UART_OVERFLOW_BLOCK)
+                        #endif
+                        {
+                            uart_tx_discard(length);
+                            return 0;
+                        }
+
+                        #if UART_RTOS > 0
+                            space = 0;      // Wait like on a full queue, the ISR wakes the task while the frame drains
+                        #endif
+                    }
+                #endif
+
+                if (space < length)
+                {
+                    if (policy == UART_OVERFLOW_DROP_OLDEST)
+                    {
+                        unsigned char tail = uart_tx_tail;
+                        unsigned char missing = length - space;
+                        unsigned char committed = (uart_tx_commit - tail) & UART_TX_BUFFER_MASK;
+
+                        if (missing > committed)
+                        {
+                            missing = committed;
+                        }
+
+                        uart_tx_tail = (tail + missing) & UART_TX_BUFFER_MASK;
+                        uart_tx_discard(missing);
+                        space += missing;
+                    }
+
+                    if (policy == UART_OVERFLOW_DROP_MESSAGE || ((flags & UART_TX_WHOLE) && policy != UART_OVERFLOW_BLOCK && space < length))
+                    {
+                        uart_tx_discard(length);
+                        return 0;
+                    }
+                    else if (policy != UART_OVERFLOW_BLOCK && space < length)
+                    {
+                        uart_tx_discard(length - space);
+                        length = space;
+                    }
+                    #if UART_TX_BUFFER_SIZE < 256
+                        else if (length > UART_TX_BUFFER_MASK)
+                        {
+                            // Can never fit, waiting would block forever
+                            uart_tx_discard(length);
+                            return 0;
+                        }
+                    #endif
+                }
+
+                if (space >= length)
+                {
+                    if (length)
+                    {
+                        *start = reserve;
+                        uart_tx_reserve = (reserve + length) & UART_TX_BUFFER_MASK;
+                        uart_tx_writers++;
+                    }
+                    return length;
+                }
+
+                #if UART_RTOS > 0
+                    if (blocking)
+                    {
+                        // Registered in the same critical section, the ISR cannot miss the waiter
+                        if (!uart_tx_waiting || length < uart_tx_needed)
+                        {
+                            uart_tx_needed = length;
+                        }
+                        uart_tx_waiting++;
+                    }
+                #endif
+
+                #if UART_HANDSHAKE == 2
+                    uart_tx_resume();
+                #endif
+            }
+
+            #if UART_RTOS > 0
+                if (blocking)
+                {
+                    xSemaphoreTake(uart_tx_semaphore, portMAX_DELAY);
+                    continue;
+                }
+            #endif
+
+            if (!(SREG & (1<<SREG_I)))
+            {
+                // Nothing this producer can drain by itself (uncommitted data, while pacing no tokens as uart_tick() cannot run, a running stream owns UDR)
+                #if UART_TX_PACING > 0
+                    if (uart_tx_tail == uart_tx_commit || UART_TX_REMOTE_PAUSED() || !uart_tx_tokens || uart_tx_gap)
+                #elif UART_STREAM > 0
+                    if (uart_tx_tail == uart_tx_commit || UART_TX_REMOTE_PAUSED() || uart_stream_active)
+                #else
+                    if (uart_tx_tail == uart_tx_commit || UART_TX_REMOTE_PAUSED())
+                #endif
+                {
+                    uart_tx_discard(length);
+                    return 0;
+                }
+
+                #if UART_DITHER > 0
+                    if (UCSRB & (1<<TXCIE))
+                    {
+                        // Do the work of ISR(UART_TXC_vect) by polling
+                        while (!(UCSRA & (1<<TXC)));
+                        UCSRB &= ~(1<<TXCIE);
+                        uart_tx_dither_next();
+                    }
+                #endif
+
+                while (!(UCSRA & (1<<UDRE)));
+                uart_tx_next();
+            }
+        }
+    }
+
+    /**
+     * @brief Publish a completely written reservation to the transmitter.
+     *
+     * @details
+     * The commit index only moves when the last open reservation is closed. Nested producers (an ISR interrupting a main loop producer) are therefore sent after the interrupted message, each one contiguous.
+     */
+    static void uart_tx_commit_space(void)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (--uart_tx_writers == 0)
+            {
+                uart_tx_commit = uart_tx_reserve;
+                uart_tx_start();
+            }
+        }
+    }
+
+    /**
+     * @brief Select the overflow policy of the transmit queue.
+     *
+     * @param policy UART_OVERFLOW_BLOCK, UART_OVERFLOW_DROP_NEWEST, UART_OVERFLOW_DROP_OLDEST or UART_OVERFLOW_DROP_MESSAGE.
+     * @return Previous policy.
+     *
+     * @details
+     * The policy applies to all producers. Output with its own policy (e.g. log lines that must never stall the caller) uses uart_write_policy() instead of switching the policy, which would also affect ISRs and other tasks writing meanwhile.
+     */
+    unsigned char uart_tx_overflow(unsigned char policy)
+    {
+        unsigned char previous = uart_tx_policy;
+
+        uart_tx_policy = policy;
+        return previous;
+    }
+
+    /**
+     * @brief Read and reset the number of discarded transmit bytes.
+     *
+     * @return Number of bytes discarded by the overflow policy since the last call.
+     */
+    uint16_t uart_tx_discarded(void)
+    {
+        uint16_t count;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            count = uart_tx_discarded_count;
+            uart_tx_discarded_count = 0;
+        }
+        return count;
+    }
+
+    #if UART_STREAM > 0
+        /**
+         * @brief Start streaming.
+         *
+         * @param producer Called (from the ISR) whenever a buffer has become free, NULL if the main loop polls uart_stream_buffer().
+         *
+         * @details
+         * Both buffers are free after the start and the producer is called once. It fills buffers as long as uart_stream_buffer() returns one. Transmission starts with the first submit.
+         *
+         * @code
+         * static void stream_producer(void)
+         * {
+         *     unsigned char *buffer;
+         *
+         *     while ((buffer = uart_stream_buffer()) && adc_samples() >= UART_STREAM_SIZE)
+         *     {
+         *         adc_copy(buffer, UART_STREAM_SIZE);
+         *         uart_stream_submit(UART_STREAM_SIZE);
+         *     }
+         * }
+         *
+         * uart_stream_start(stream_producer);
+         * @endcode
+         */
+        void uart_stream_start(void (*producer)(void))
+        {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_stream_length[0] = 0;
+                uart_stream_length[1] = 0;
+                uart_stream_half = 0;
+                uart_stream_index = 0;
+                uart_stream_fill = 0;
+                uart_stream_starved = 1;        // Nothing submitted yet is not an underrun
+                uart_stream_producer = producer;
+                uart_stream_active = 1;
+            }
+
+            if (producer)
+            {
+                producer();
+            }
+        }
+
+        /**
+         * @brief Get the buffer the producer fills next.
+         *
+         * @return Buffer of UART_STREAM_SIZE bytes, NULL if both buffers are submitted.
+         */
+        unsigned char *uart_stream_buffer(void)
+        {
+            unsigned char fill = uart_stream_fill;
+
+            return uart_stream_length[fill] ? NULL : uart_stream_data[fill];
+        }
+
+        /**
+         * @brief Submit the buffer returned by uart_stream_buffer() for transmission.
+         *
+         * @param length Number of bytes written to the buffer (1 - UART_STREAM_SIZE).
+         */
+        void uart_stream_submit(unsigned char length)
+        {
+            if (!length)
+            {
+                return;
+            }
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                unsigned char fill = uart_stream_fill;
+
+                uart_stream_length[fill] = (length > UART_STREAM_SIZE) ? UART_STREAM_SIZE : length;
+                uart_stream_fill = fill ^ 1;
+                uart_stream_starved = 0;
+                UCSRB |= (1<<UDRIE);
+            }
+        }
+
+        /**
+         * @brief Stop streaming after the submitted buffers have been transmitted.
+         *
+         * @details
+         * Must be called with interrupts enabled. Data queued with uart_putchar()/uart_write() in the meantime is transmitted afterwards. Call before uart_flush().
+         */
+        void uart_stream_stop(void)
+        {
+            while (uart_stream_length[0] || uart_stream_length[1]);
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_stream_active = 0;
+                uart_stream_producer = NULL;
+
+                if (uart_tx_tail != uart_tx_commit)
+                {
+                    uart_tx_start();
+                }
+            }
+        }
+
+        /**
+         * @brief Read and reset the number of stream underruns.
+         *
+         * @return Number of times the line went idle because no buffer had been submitted, since the last call.
+         */
+        uint16_t uart_stream_underruns(void)
+        {
+            uint16_t count;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                count = uart_stream_underrun_count;
+                uart_stream_underrun_count = 0;
+            }
+            return count;
+        }
+    #endif
+#endif
+
+#if UART_RX_COALESCE > 0
+    /**
+     * @brief Signal the consumer that received data is waiting.
+     *
+     * @details
+     * Called with interrupts disabled from the receive ISR (count reached) or uart_tick() (idle timeout).
+     */
+    static void uart_rx_signal(void)
+    {
+        void (*callback)(void) = uart_rx_callback;
+
+        uart_rx_pending = 0;
+        uart_rx_idle = 0;
+        uart_rx_signalled = 1;
+
+        if (callback)
+        {
+            callback();
+        }
+    }
+
+    /**
+     * @brief Register the consumer callback of the receive moderation.
+     *
+     * @param callback Function called from ISR context when UART_RX_COALESCE_COUNT bytes are waiting or the idle timeout expired, NULL to poll with uart_rx_ready() only.
+     *
+     * @note The callback runs with interrupts disabled and should only wake the consumer (e.g. set a flag or give a semaphore).
+     */
+    void uart_rx_notify(void (*callback)(void))
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            uart_rx_callback = callback;
+        }
+    }
+
+    /**
+     * @brief Take the receive moderation signal.
+     *
+     * @return Number of bytes in the receive queue if the consumer has been signalled since the last call, 0 otherwise.
+     */
+    unsigned char uart_rx_ready(void)
+    {
+        unsigned char count = 0;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (uart_rx_signalled)
+            {
+                uart_rx_signalled = 0;
+                count = (uart_rx_head - uart_rx_tail) & UART_RX_BUFFER_MASK;
+            }
+        }
+        return count;
+    }
+#endif
+
+#if UART_FRAME > 0
+    /**
+     * @brief Write a byte of a frame without updating the CRC.
+     *
+     * @param stream Frame state.
+     * @param data Byte to write.
+     */
+    static void uart_frame_raw(struct uart_frame_stream *stream, uint8_t data)
+    {
+        #if UART_TX_BUFFER_SIZE > 0
+            if (stream->queued)
+            {
+                uart_tx_buffer[stream->index] = data;
+                stream->index = (stream->index + 1) & UART_TX_BUFFER_MASK;
+                return;
+            }
+        #endif
+
+        uart_tx_put(data, UART_TX_FRAME);
+    }
+
+    /**
+     * @brief Write a byte of the length prefix or payload of a frame.
+     *
+     * @param stream Frame state.
+     * @param data Byte to write.
+     */
+    static void uart_frame_byte(struct uart_frame_stream *stream, uint8_t data)
+    {
+        #if UART_FRAME_CRC > 0
+            stream->crc = _crc_xmodem_update(stream->crc, data);
+        #endif
+
+        uart_frame_raw(stream, data);
+    }
+
+    /**
+     * @brief Start a frame and write its length prefix.
+     *
+     * @param stream Frame state.
+     * @param length Payload length in bytes.
+     * @return 0 on success, 1 if the length cannot be encoded or the frame has been discarded by the transmit overflow policy.
+     *
+     * @details
+     * A frame that fits into the transmit queue is reserved as one message. Larger frames (and all frames without transmit queue) are written byte by byte. Until the frame is closed, the messages of other producers (e.g. ISRs) are discarded instead of being sent inside the frame, see uart_tx_reserve_space().
+     */
+    static char uart_frame_open(struct uart_frame_stream *stream, uint16_t length)
+    {
+        #if UART_FRAME_LENGTH_BYTES == 1
+            if (length > 255)
+            {
+                return 1;
+            }
+        #endif
+
+        stream->remaining = length;
+        stream->fault = 0;
+
+        #if UART_FRAME_CRC > 0
+            stream->crc = 0;
+        #endif
+
+        #if UART_TX_BUFFER_SIZE > 0
+            stream->queued = 0;
+
+            if (length <= (UART_TX_BUFFER_MASK - UART_FRAME_OVERHEAD))
+            {
+                unsigned char start;
+
+                if (!uart_tx_reserve_space((unsigned char)(length + UART_FRAME_OVERHEAD), &start, UART_TX_WHOLE, uart_tx_policy))
+                {
+                    return 1;
+                }
+                stream->index = start;
+                stream->queued = 1;
+            }
+            else
+        #endif
+        {
+            uart_frame_direct = 1;
+        }
+
+        stream->open = 1;
+
+        #if UART_FRAME_LENGTH_BYTES == 2
+            uart_frame_byte(stream, (uint8_t)(length >> 8));
+        #endif
+
+        uart_frame_byte(stream, (uint8_t)length);
+        return 0;
+    }
+
+    /**
+     * @brief Write payload bytes of a frame.
+     *
+     * @param stream Frame state.
+     * @param data Payload bytes.
+     * @param length Number of bytes, anything beyond the announced length is discarded.
+     */
+    static void uart_frame_payload(struct uart_frame_stream *stream, const uint8_t *data, uint16_t length)
+    {
+        if (length > stream->remaining)
+        {
+            length = stream->remaining;
+            stream->fault = 1;
+        }
+
+        stream->remaining -= length;
+
+        while (length--)
+        {
+            uart_frame_byte(stream, *data++);
+        }
+    }
+
+    /**
+     * @brief Complete a frame with the CRC and hand it to the transmitter.
+     *
+     * @param stream Frame state.
+     * @return 0 on success, 1 if the payload did not match the announced length.
+     *
+     * @details
+     * Missing payload bytes are padded with 0, so the receiver stays in sync.
+     */
+    static char uart_frame_close(struct uart_frame_stream *stream)
+    {
+        while (stream->remaining)
+        {
+            stream->remaining--;
+            stream->fault = 1;
+            uart_frame_byte(stream, 0);
+        }
+
+        #if UART_FRAME_CRC > 0
+            uart_frame_raw(stream, (uint8_t)(stream->crc >> 8));
+            uart_frame_raw(stream, (uint8_t)stream->crc);
+        #endif
+
+        #if UART_TX_BUFFER_SIZE > 0
+            if (stream->queued)
+            {
+                uart_tx_commit_space();
+            }
+            else
+        #endif
+        {
+            uart_frame_direct = 0;
+        }
+
+        stream->open = 0;
+        return stream->fault;
+    }
+
+    /**
+     * @brief Write a complete frame.
+     *
+     * @param data Payload bytes.
+     * @param length Payload length in bytes.
+     * @return 0 on success, 1 if the frame has been discarded.
+     */
+    static char uart_frame_emit(const uint8_t *data, uint16_t length)
+    {
+        struct uart_frame_stream stream;
+
+        if (uart_frame_open(&stream, length))
+        {
+            return 1;
+        }
+
+        uart_frame_payload(&stream, data, length);
+        return uart_frame_close(&stream);
+    }
+
+    /**
+     * @brief Send a payload as frame.
+     *
+     * @param data Payload bytes.
+     * @param length Payload length in bytes (UART_FRAME_LENGTH_BYTES 1: up to 255).
+     * @return 0 on success, 1 if a frame has been discarded.
+     *
+     * @details
+     * With UART_FRAME_COALESCE the payload is appended to the pending frame, which is sent at UART_FRAME_COALESCE_SIZE bytes, after UART_FRAME_COALESCE_DELAY ticks or with uart_frame_flush(). A payload that does not fit into the pending frame sends it first, a payload of UART_FRAME_COALESCE_SIZE bytes or more is sent as its own frame.
+     *
+     * @note Frame functions are meant for one context (e.g. the main loop), uart_write() and uart_putchar() can still be used from ISRs.
+     */
+    char uart_frame_write(const void *data, uint16_t length)
+    {
+        #if UART_FRAME_COALESCE > 0
+            const uint8_t *bytes = (const uint8_t *)data;
+            unsigned char send;
+            char fault = 0;
+
+            // The tick can only empty the pending frame, the free space never shrinks behind this check
+            if (length > (uint16_t)(UART_FRAME_COALESCE_SIZE - uart_frame_fill))
+            {
+                fault = uart_frame_flush();
+
+                if (length >= UART_FRAME_COALESCE_SIZE)
+                {
+                    return uart_frame_emit(bytes, length) | fault;
+                }
+            }
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                unsigned char fill = uart_frame_fill;
+
+                if (!fill)
+                {
+                    uart_frame_timer = UART_FRAME_COALESCE_DELAY;
+                }
+
+                for (unsigned char i = 0; i < (unsigned char)length; i++)
+                {
+                    uart_frame_pending[fill++] = bytes[i];
+                }
+
+                uart_frame_fill = fill;
+                send = (fill >= UART_FRAME_COALESCE_SIZE);
+            }
+
+            if (send)
+            {
+                fault |= uart_frame_flush();
+            }
+            return fault;
+        #else
+            return uart_frame_emit((const uint8_t *)data, length);
+        #endif
+    }
+
+    /**
+     * @brief Send the pending frame immediately.
+     *
+     * @return 0 on success, 1 if the frame has been discarded.
+     *
+     * @details
+     * Used after latency-sensitive writes. Without UART_FRAME_COALESCE every frame is sent immediately and the function has nothing to do.
+     */
+    char uart_frame_flush(void)
+    {
+        #if UART_FRAME_COALESCE > 0
+            unsigned char length;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                // Taking the fill level hands the buffer over, uart_tick() ignores an empty pending frame
+                length = uart_frame_fill;
+                uart_frame_fill = 0;
+                uart_frame_timer = 0;
+            }
+
+            if (length)
+            {
+                return uart_frame_emit(uart_frame_pending, length);
+            }
+        #endif
+
+        return 0;
+    }
+
+    /**
+     * @brief Start a frame that is written in parts.
+     *
+     * @param length Payload length in bytes.
+     * @return 0 on success, 1 if the frame has been discarded (uart_frame_put() and uart_frame_end() are ignored).
+     *
+     * @details
+     * A pending coalesced frame is sent first. The payload is written with uart_frame_put() and completed with uart_frame_end(), without an intermediate buffer. A frame that fits into the transmit queue holds its reservation until uart_frame_end(), so the parts should follow without delay.
+     */
+    char uart_frame_begin(uint16_t length)
+    {
+        char fault = uart_frame_flush();
+
+        if (uart_frame_active.open)
+        {
+            uart_frame_close(&uart_frame_active);
+            fault = 1;
+        }
+        return uart_frame_open(&uart_frame_active, length) | fault;
+    }
+
+    /**
+     * @brief Write a part of the payload of the frame started with uart_frame_begin().
+     *
+     * @param data Payload bytes.
+     * @param length Number of bytes.
+     */
+    void uart_frame_put(const void *data, uint16_t length)
+    {
+        if (uart_frame_active.open)
+        {
+            uart_frame_payload(&uart_frame_active, (const uint8_t *)data, length);
+        }
+    }
+
+    /**
+     * @brief Complete the frame started with uart_frame_begin().
+     *
+     * @return 0 on success, 1 if the frame has been discarded or the payload did not match the announced length.
+     */
+    char uart_frame_end(void)
+    {
+        if (!uart_frame_active.open)
+        {
+            return 1;
+        }
+        return uart_frame_close(&uart_frame_active);
+    }
+
+    #if UART_FRAME_RX > 0
+        /**
+         * @brief Prepare the frame parser for the next length prefix.
+         */
+        static inline void uart_frame_rx_reset(void)
+        {
+            uart_frame_rx_phase = 0;
+            uart_frame_rx_count = UART_FRAME_LENGTH_BYTES;
+            uart_frame_rx_length = 0;
+            uart_frame_rx_crc = 0;
+            uart_frame_rx_drop = 0;
+        }
+
+        /**
+         * @brief Publish or discard the frame the parser has just completed.
+         */
+        static void uart_frame_rx_complete(void)
+        {
+            #if UART_FRAME_CRC > 0
+                // CRC-16/XMODEM over data and its own big-endian CRC is 0
+                if (uart_frame_rx_crc)
+                {
+                    uart_frame_rx_drop = 1;
+                }
+            #endif
+
+            if (uart_frame_rx_drop)
+            {
+                uart_frame_rx_rejected++;
+            }
+            else
+            {
+                void (*callback)(void) = uart_frame_rx_callback;
+
+                uart_rx_head = uart_frame_rx_write;
+                uart_frame_rx_frames++;
+
+                #if UART_HANDSHAKE > 0
+                    if (uart_rx_policy == UART_OVERFLOW_BLOCK && !uart_rx_paused && ((uart_frame_rx_write - uart_rx_tail) & UART_RX_BUFFER_MASK) >= UART_RX_HANDSHAKE_HIGH)
+                    {
+                        uart_rx_paused = 1;
+                        uart_handshake(UART_Pause);
+                    }
+                #endif
+
+                if (callback)
+                {
+                    callback();
+                }
+            }
+
+            uart_frame_rx_reset();
+        }
+
+        /**
+         * @brief Feed a received byte to the frame parser.
+         *
+         * @param data Received byte.
+         * @param fault Byte has been received with frame, overrun or parity error.
+         *
+         * @details
+         * Called from ISR(UART_RXC_vect) only. Length prefix and payload are written behind the visible end of the receive queue, uart_rx_head only moves when the frame is complete. The payload of a frame that is too long or does not fit is counted but not stored, which keeps the parser in sync with the sender.
+         */
+        static inline void uart_frame_receive(uint8_t data, unsigned char fault)
+        {
+            #if UART_FRAME_RX_TIMEOUT > 0
+                uart_frame_rx_idle = UART_FRAME_RX_TICKS;
+            #endif
+
+            #if UART_FRAME_CRC > 0
+                uart_frame_rx_crc = _crc_xmodem_update(uart_frame_rx_crc, data);
+            #endif
+
+            if (fault)
+            {
+                uart_frame_rx_drop = 1;
+            }
+
+            if (uart_frame_rx_phase == 0)
+            {
+                uint16_t length = (uart_frame_rx_length << 8) | data;
+
+                uart_frame_rx_length = length;
+
+                if (--uart_frame_rx_count)
+                {
+                    return;
+                }
+
+                if (length > UART_FRAME_RX_MAX || (length + UART_FRAME_LENGTH_BYTES) > ((uart_rx_tail - uart_rx_head - 1) & UART_RX_BUFFER_MASK))
+                {
+                    uart_frame_rx_drop = 1;
+                }
+                else
+                {
+                    // Store the prefix in front of the payload, uart_frame_read() takes the frame length from it
+                    unsigned char write = uart_rx_head;
+
+                    #if UART_FRAME_LENGTH_BYTES == 2
+                        uart_rx_buffer[write] = (char)(length >> 8);
+                        write = (write + 1) & UART_RX_BUFFER_MASK;
+                    #endif
+
+                    uart_rx_buffer[write] = (char)length;
+                    uart_frame_rx_write = (write + 1) & UART_RX_BUFFER_MASK;
+                }
+
+                uart_frame_rx_count = length;
+                uart_frame_rx_phase = 1;
+            }
+            else if (uart_frame_rx_phase == 1)
+            {
+                if (!uart_frame_rx_drop)
+                {
+                    uart_rx_buffer[uart_frame_rx_write] = data;
+                    uart_frame_rx_write = (uart_frame_rx_write + 1) & UART_RX_BUFFER_MASK;
+                }
+                uart_frame_rx_count--;
+            }
+            else
+            {
+                uart_frame_rx_count--;
+            }
+
+            if (!uart_frame_rx_count)
+            {
+                #if UART_FRAME_CRC > 0
+                    if (uart_frame_rx_phase == 1)
+                    {
+                        uart_frame_rx_count = 2;
+                        uart_frame_rx_phase = 2;
+                        return;
+                    }
+                #endif
+
+                uart_frame_rx_complete();
+            }
+        }
+
+        /**
+         * @brief Read the next complete frame from the receive queue.
+         *
+         * @param[out] data Buffer for the payload.
+         * @param size Size of the buffer in bytes.
+         * @param[out] length Payload length of the frame.
+         * @return UART_Empty if no frame is available, UART_Received if the frame has been read, UART_Fault if the payload was larger than size (only size bytes are stored, the rest is discarded).
+         *
+         * @details
+         * The payload is copied with interrupts enabled, the ISR never writes into the part of the queue that has been published.
+         */
+        UART_Data uart_frame_read(void *data, uint16_t size, uint16_t *length)
+        {
+            uint8_t *bytes = (uint8_t *)data;
+            unsigned char tail = uart_rx_tail;
+            unsigned char fill;
+            uint16_t count;
+
+            if (!uart_frame_rx_frames)
+            {
+                return UART_Empty;
+            }
+
+            #if UART_FRAME_LENGTH_BYTES == 2
+                count = (uint16_t)(uint8_t)uart_rx_buffer[tail] << 8;
+                tail = (tail + 1) & UART_RX_BUFFER_MASK;
+                count |= (uint8_t)uart_rx_buffer[tail];
+            #else
+                count = (uint8_t)uart_rx_buffer[tail];
+            #endif
+
+            tail = (tail + 1) & UART_RX_BUFFER_MASK;
+            *length = count;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                if (i < size)
+                {
+                    bytes[i] = uart_rx_buffer[tail];
+                }
+                tail = (tail + 1) & UART_RX_BUFFER_MASK;
+            }
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_rx_tail = tail;
+                uart_frame_rx_frames--;
+                fill = (uart_rx_head - tail) & UART_RX_BUFFER_MASK;
+            }
+
+            #if UART_HANDSHAKE > 0
+                if (uart_rx_paused && fill <= UART_RX_HANDSHAKE_LOW)
+                {
+                    uart_rx_paused = 0;
+                    uart_handshake(UART_Ready);
+                }
+            #else
+                (void)fill;
+            #endif
+
+            return (count > size) ? UART_Fault : UART_Received;
+        }
+
+        /**
+         * @brief Number of complete frames in the receive queue.
+         *
+         * @return Number of frames that can be read with uart_frame_read().
+         */
+        unsigned char uart_frame_available(void)
+        {
+            return uart_frame_rx_frames;
+        }
+
+        /**
+         * @brief Register the callback for complete frames.
+         *
+         * @param callback Function called from ISR context for every complete and valid frame, NULL to poll with uart_frame_available() only.
+         *
+         * @note The callback runs inside the receive ISR and should only wake the consumer (e.g. set a flag or give a semaphore).
+         */
+        void uart_frame_notify(void (*callback)(void))
+        {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_frame_rx_callback = callback;
+            }
+        }
+
+        /**
+         * @brief Read and reset the number of discarded frames.
+         *
+         * @return Number of frames discarded since the last call (too long, no space, CRC mismatch, receive error or timeout).
+         */
+        uint16_t uart_frame_rejected(void)
+        {
+            uint16_t count;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                count = uart_frame_rx_rejected;
+                uart_frame_rx_rejected = 0;
+            }
+            return count;
+        }
+    #endif
+#endif
+
+#ifdef UART_TICK_USED
+    /**
+     * @brief Time base of the timed driver features.
+     *
+     * @details
+     * Has to be called at UART_TICK_HZ, typically from an existing timer compare ISR. Refills the transmit token bucket and restarts the transmit queue (UART_TX_PACING), signals the receive idle timeout (UART_RX_COALESCE) and sends the pending frame after its delay (UART_FRAME_COALESCE).
+     */
+    void uart_tick(void)
+    {
+        #if UART_FRAME_RX_TIMEOUT > 0
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                if (uart_frame_rx_idle && !--uart_frame_rx_idle && (uart_frame_rx_phase || uart_frame_rx_count != UART_FRAME_LENGTH_BYTES))
+                {
+                    uart_frame_rx_rejected++;
+                    uart_frame_rx_reset();
+                }
+            }
+        #endif
+
+        #if UART_FRAME_COALESCE > 0
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                if (uart_frame_timer && !--uart_frame_timer && uart_frame_fill)
+                {
+                    unsigned char length = uart_frame_fill;
+
+                    // Never wait in ISR context, and never split a frame that is written byte by byte
+                    if (uart_frame_direct || ((uart_tx_tail - uart_tx_reserve - 1) & UART_TX_BUFFER_MASK) < (length + UART_FRAME_OVERHEAD))
+                    {
+                        uart_frame_timer = 1;
+                    }
+                    else
+                    {
+                        uart_frame_fill = 0;
+                        uart_frame_emit(uart_frame_pending, length);
+                    }
+                }
+            }
+        #endif
+
+        #if UART_RX_COALESCE > 0
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                if (uart_rx_idle && !--uart_rx_idle)
+                {
+                    #if UART_EVENT > 0
+                        uart_event_post(UART_EVENT_IDLE, 1);
+                    #endif
+
+                    if (uart_rx_pending)
+                    {
+                        uart_rx_signal();
+                    }
+                }
+            }
+        #endif
+
+        #if UART_TX_PACING > 0
+            uint16_t tokens = uart_tx_tokens;
+
+            // Refill UART_TX_PACING_RATE / UART_TICK_HZ tokens, the remainder is accumulated
+            tokens += (uint16_t)(UART_TX_PACING_RATE / UART_TICK_HZ);
+            uart_tx_pacing += (uint16_t)(UART_TX_PACING_RATE % UART_TICK_HZ);
+
+            if (uart_tx_pacing >= UART_TICK_HZ)
+            {
+                uart_tx_pacing -= UART_TICK_HZ;
+                tokens++;
+            }
+
+            if (tokens > UART_TX_PACING_BURST)
+            {
+                tokens = UART_TX_PACING_BURST;
+            }
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_tx_tokens = (unsigned char)tokens;
+
+                if (uart_tx_gap)
+                {
+                    uart_tx_gap--;
+                }
+
+                if (uart_tx_tail != uart_tx_commit)
+                {
+                    uart_tx_start();
+                }
+            }
+        #endif
+
+        #if UART_HANDSHAKE == 2 && UART_TX_BUFFER_SIZE > 0
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                uart_tx_resume();
+            }
+        #endif
+    }
+#endif
+
+#if UART_RX_BUFFER_SIZE > 0
+    /**
+     * @brief Count discarded receive bytes.
+     *
+     * @param count Number of discarded bytes.
+     */
+    static inline void uart_rx_discard(unsigned char count)
+    {
+        uart_rx_discarded_count += count;
+
+        #if UART_EVENT > 0
+            uart_event_post(UART_EVENT_RX_OVERFLOW, count);
+        #endif
+    }
+
+    /**
+     * @brief Append a received byte to the receive queue.
+     *
+     * @param data Received byte.
+     *
+     * @details
+     * Called from ISR(UART_RXC_vect) only. Applies the receive overflow policy (see uart_rx_overflow()) and pauses the remote when the queue fills up (UART_OVERFLOW_BLOCK with UART_HANDSHAKE > 0).
+     */
+    static inline void uart_rx_store(char data)
+    {
+        unsigned char head = uart_rx_head;
+        unsigned char next = (head + 1) & UART_RX_BUFFER_MASK;
+
+        if (uart_rx_skip)
+        {
+            uart_rx_discard(1);
+
+            if (data == UART_RX_MESSAGE_DELIMITER)
+            {
+                uart_rx_skip = 0;
+                uart_rx_message = head;
+            }
+            return;
+        }
+
+        if (next == uart_rx_tail)
+        {
+            switch (uart_rx_policy)
+            {
+                case UART_OVERFLOW_DROP_OLDEST:
+                    if (uart_rx_message == uart_rx_tail)
+                    {
+                        uart_rx_message = (uart_rx_message + 1) & UART_RX_BUFFER_MASK;
+                    }
+                    uart_rx_tail = (uart_rx_tail + 1) & UART_RX_BUFFER_MASK;
+                    uart_rx_discard(1);
+                    break;
+
+                case UART_OVERFLOW_DROP_MESSAGE:
+                    // Remove the partial message and skip its remainder
+                    uart_rx_discard(((head - uart_rx_message) & UART_RX_BUFFER_MASK) + 1);
+                    uart_rx_head = uart_rx_message;
+                    uart_rx_skip = (data != UART_RX_MESSAGE_DELIMITER);
+                    return;
+
+                default:
+                    uart_rx_discard(1);
+                    return;
+            }
+        }
+
+        uart_rx_buffer[head] = data;
+        uart_rx_head = next;
+
+        #if UART_RX_COALESCE > 0
+            uart_rx_idle = UART_RX_COALESCE_TICKS;
+
+            if (++uart_rx_pending >= UART_RX_COALESCE_COUNT)
+            {
+                uart_rx_signal();
+            }
+        #endif
+
+        if (data == UART_RX_MESSAGE_DELIMITER)
+        {
+            uart_rx_message = next;
+        }
+
+        #if UART_EVENT > 0
+            // The fill level grows by one, equality only matches on the way up
+            if (((next - uart_rx_tail) & UART_RX_BUFFER_MASK) == UART_EVENT_RX_WATERMARK)
+            {
+                uart_event_post(UART_EVENT_RX_HIGH, 1);
+            }
+        #endif
+
+        #if UART_HANDSHAKE > 0
+            if (uart_rx_policy == UART_OVERFLOW_BLOCK && !uart_rx_paused && ((next - uart_rx_tail) & UART_RX_BUFFER_MASK) >= UART_RX_HANDSHAKE_HIGH)
+            {
+                uart_rx_paused = 1;
+                uart_handshake(UART_Pause);
+            }
+        #endif
+    }
 
-/**
- * @brief Initialize the UART hardware interface with configured parameters.
- *
- * @details
- * This function configures the USART peripheral for polling-based operation:
- * - Sets hardware handshake pins (RTS/CTS) if UART_HANDSHAKE==2
- * - Calculates and applies baud rate using setbaud.h
- * - Configures frame format: data bits, parity, stop bits
- * - Enables TX/RX with optional RXC echo and stdio stream assignment
- *
- * All configuration is derived from uart.h preprocessor macros.
- *
- * @note Call this function once during system initialization before using UART functions.
- * @note stdio streams (stdout/stdin) are assigned only when UART_STDMODE > 0 and no interrupts defined.
- */
-void uart_init(void)
-{
-    // Check if hardware flow control is enabled
-    #if UART_HANDSHAKE == 2
-        // Setup RTS (output)/CTS (input)
-        UART_HANDSHAKE_DDR |= (1<<UART_HANDSHAKE_RTS_PIN);
-        UART_HANDSHAKE_DDR &= ~(1<<UART_HANDSHAKE_CTS_PIN);
-    #endif
-    
-    // Check which bit sampling mode should be activated
-    #if USE_2X
-        UCSRA |= (1<<U2X);          // Setup 8 samples/bit
-    #else
-        UCSRA &= ~(1<<U2X);         // Setup 16 samples/bit
-    #endif
+    /**
+     * @brief Receive Complete interrupt, fills the receive queue.
+     *
+     * @details
+     * Status flags have to be read before UDR. Bytes with frame, overrun or parity error are discarded and the error is latched for uart_scanchar()/uart_error_flags(). With UART_FRAME_RX every byte is passed to the frame parser instead of the queue.
+     */
+    static inline void uart_rx_receive(void)
+    {
+        unsigned char status = UCSRA;
+        char data = UDR;
 
-    UBRRH = UBRRH_VALUE;            // Calculated through setbaud.h
-    UBRRL = UBRRL_VALUE;            // Calculated through setbaud.h
+        #if UART_FRAME_RX > 0
+            // A faulty byte still takes its place in the frame, the frame is discarded at its end
+            uart_frame_receive((uint8_t)data, status & ((1<<FE) | (1<<DOR) | (1<<UPE)));
+        #endif
 
-    unsigned char SETREG = (1<<URSEL);  // Activate URSEL (normally in register UCSRC)
-    
-    SETREG |= ((0x03 & (UART_DATASIZE - 5))<<UCSZ0);		// Setup data size
-    
-    #if UART_PARITY > 0
-        SETREG |= ((0x03 & (UART_PARITY + 1))<<UPM0);		// UART_Parity Mode
-    #endif
-    
-    #if UART_STOPBITS > 1
-        SETREG |= ((0x01 & (UART_STOPBITS - 1))<<USBS);     // Setup stop bits
-    #endif
-    
-    UCSRC = SETREG;                 // Write SETREG settings to UCSRC
-    UCSRB = (1<<RXEN) | (1<<TXEN);  // Activate UART transmitter and receiver
+        if (status & (1<<FE))
+        {
+            uart_rx_error = UART_Frame;
 
-    // Interrupt control
-    
-    // Receiver interrupt setup
-    #ifdef UART_RXCIE
-        UCSRB |= (1<<RXCIE);
-    #endif
+            #if UART_EVENT > 0
+                // A break holds the line low for a whole character and longer
+                uart_event_post(data ? UART_EVENT_FRAME : UART_EVENT_BREAK, 1);
+            #endif
+            return;
+        }
+        else if (status & (1<<DOR))
+        {
+            uart_rx_error = UART_Overrun;
 
-    // Transmitter interrupt setup
-    #if defined(UART_TXCIE) && !defined(UART_UDRIE)
-        UCSRB |= (1<<TXCIE);
-    #endif
+            #if UART_EVENT > 0
+                uart_event_post(UART_EVENT_OVERRUN, 1);
+            #endif
+            return;
+        }
+        else if (status & (1<<UPE))
+        {
+            uart_rx_error = UART_Parity;
 
-    // Transmitter interrupt setup
-    #if !defined(UART_TXCIE) && defined(UART_UDRIE)
-        UCSRB |= (1<<UDRIE);
-    #endif
+            #if UART_EVENT > 0
+                uart_event_post(UART_EVENT_PARITY, 1);
+            #endif
+            return;
+        }
 
-    #if !defined(UART_TXCIE) && !defined(UART_UDRIE) && (UART_STDMODE == 1 || UART_STDMODE == 2)
-        stdout = &std_uart;
-    #endif
-    
-    #if !defined(UART_RXCIE) && UART_STDMODE == 1 || UART_STDMODE == 3
-        stdin = &std_uart;
-    #endif
-}
+        #if UART_HANDSHAKE == 1
+            if (data == UART_HANDSHAKE_XON)
+            {
+                #if UART_EVENT > 0
+                    if (uart_handshake_sending != UART_Ready)
+                    {
+                        uart_event_post(UART_EVENT_XON, 1);
+                    }
+                #endif
 
-/**
- * @brief Disable the UART hardware interface and reset configuration.
- *
- * @details
- * This function completely disables the USART peripheral by clearing TXEN/RXEN bits and all interrupt enables. Call before reconfiguring UART or entering power-save modes.
- */
-void uart_disable(void)
-{
-    
-    UCSRB &= ~((1<<RXEN) | (1<<TXEN));
-	UCSRB &= ~((1<<RXCIE) | (1<<TXCIE) | (1<<UDRIE));
-	UCSRA |= (1<<TXC);
-	
-	#if !defined(UART_TXCIE) && !defined(UART_UDRIE) && (UART_STDMODE == 1 || UART_STDMODE == 2)
-		stdout = NULL;
-	#endif
-	
-	#if !defined(UART_RXCIE) && UART_STDMODE == 1 || UART_STDMODE == 3
-		stdin = NULL;
-	#endif
-	
-	#if UART_HANDSHAKE == 2
-		UART_HANDSHAKE_DDR &= ~((1<<UART_HANDSHAKE_RTS_PIN) | (1<<UART_HANDSHAKE_CTS_PIN));
-	#endif
-}
+                uart_handshake_sending = UART_Ready;
+
+                #if UART_TX_BUFFER_SIZE > 0
+                    if (uart_tx_tail != uart_tx_commit)
+                    {
+                        uart_tx_start();
+                    }
+                #endif
+                return;
+            }
+            else if (data == UART_HANDSHAKE_XOFF)
+            {
+                #if UART_EVENT > 0
+                    if (uart_handshake_sending != UART_Pause)
+                    {
+                        uart_event_post(UART_EVENT_XOFF, 1);
+                    }
+                #endif
+
+                uart_handshake_sending = UART_Pause;
+                return;
+            }
+        #endif
+
+        #if defined(UART_RXC_ECHO) && !defined(UART_TXCIE) && !defined(UART_UDRIE)
+            // Send echo of received data to UART
+            uart_putchar(data);
+        #endif
+
+        #if UART_FRAME_RX == 0
+            uart_rx_store(data);
+        #endif
+    }
+
+    /**
+     * @brief Receive Complete interrupt, fills the receive queue and wakes the tasks blocked in uart_getchar().
+     */
+    ISR(UART_RXC_vect)
+    {
+        uart_rx_receive();
+
+        #if UART_RTOS > 0
+            uart_rtos_wake(uart_rx_semaphore, &uart_rx_waiting);
+            uart_rtos_yield();
+        #endif
+    }
+
+    /**
+     * @brief Select the overflow policy of the receive queue.
+     *
+     * @param policy UART_OVERFLOW_BLOCK, UART_OVERFLOW_DROP_NEWEST, UART_OVERFLOW_DROP_OLDEST or UART_OVERFLOW_DROP_MESSAGE.
+     */
+    void uart_rx_overflow(unsigned char policy)
+    {
+        uart_rx_policy = policy;
+    }
+
+    /**
+     * @brief Read and reset the number of discarded receive bytes.
+     *
+     * @return Number of bytes discarded by the overflow policy since the last call.
+     */
+    uint16_t uart_rx_discarded(void)
+    {
+        uint16_t count;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            count = uart_rx_discarded_count;
+            uart_rx_discarded_count = 0;
+        }
+        return count;
+    }
+#endif
 
 #if !defined(UART_TXCIE) && !defined(UART_UDRIE)
 	/**
      * @brief Transmit a single character via UART (blocking).
      *
      * @param data Character byte to transmit (0-255).
-     * @return Always returns 0 (success indicator for stdio compatibility).
+     * @return 0 on success, 1 if the character has been discarded (buffered mode only, see uart_tx_overflow()).
      *
      * @details
      * Polling implementation waits for DREIF (Data Register Empty) flag before writing to UDR register. Blocks until transmission completes.
+     * With UART_TX_BUFFER_SIZE > 0 the character is appended to the transmit queue and the function only blocks while the queue is full.
      *
      * @note Only available when no TX interrupts defined (UART_TXCIE/UART_UDRIE).
      */
     char uart_putchar(char data)
     {
-        // Wait until last transmission completed
-        while(!(UCSRA & (1<<UDRE)));
-        
-        UDR = data; // Write data to transmission register
+        return uart_tx_put(data, 0);
+    }
+
+    /**
+     * @brief Transmit a single character, shared by uart_putchar() and the frame writer.
+     *
+     * @param data Character byte to transmit (0-255).
+     * @param flags UART_TX_FRAME for the bytes of a frame that is written byte by byte, 0 otherwise.
+     * @return 0 on success, 1 if the character has been discarded.
+     */
+    static char uart_tx_put(char data, unsigned char flags)
+    {
+        #if UART_TX_BUFFER_SIZE > 0
+            unsigned char start;
+
+            if (!uart_tx_reserve_space(1, &start, flags, uart_tx_policy))
+            {
+                return 1;
+            }
+
+            uart_tx_buffer[start] = data;
+            uart_tx_commit_space();
+        #else
+            #if UART_FRAME > 0
+                // Other producers would end up inside the frame
+                if (uart_frame_direct && !(flags & UART_TX_FRAME))
+                {
+                    return 1;
+                }
+            #else
+                (void)flags;
+            #endif
+
+            // Wait until last transmission completed
+            while(!(UCSRA & (1<<UDRE)));
+
+            UCSRA |= (1<<TXC);  // Clear transmit complete flag (for uart_flush)
+            UDR = data; // Write data to transmission register
+            uart_tx_sent = 1;
+            uart_tx_activity = 1;
+        #endif
         
         // C99 functions needs an int as a return parameter
         return 0;   // Return that there was no fault
     }
+
+    /**
+     * @brief Transmit a block of characters as one message.
+     *
+     * @param data Pointer to the characters to transmit.
+     * @param length Number of characters to transmit.
+     * @return 0 on success, 1 if the message has not been queued completely.
+     *
+     * @details
+     * With UART_TX_BUFFER_SIZE > 0 the whole message is reserved at once and lands contiguously on the wire, even if other producers (ISRs) transmit at the same time. If the queue has no room, the overflow policy of uart_tx_overflow() applies. Messages longer than UART_TX_BUFFER_SIZE - 1 are never queued completely. Without transmit queue the characters are sent by polling.
+     */
+    char uart_write(const char *data, unsigned char length)
+    {
+        #if UART_TX_BUFFER_SIZE > 0
+            return uart_write_policy(data, length, uart_tx_policy);
+        #else
+            while (length--)
+            {
+                uart_putchar(*data++);
+            }
+            return 0;
+        #endif
+    }
+
+    #if UART_TX_BUFFER_SIZE > 0
+        /**
+         * @brief Transmit a block of characters as one message with its own overflow policy.
+         *
+         * @param data Pointer to the characters to transmit.
+         * @param length Number of characters to transmit.
+         * @param policy UART_OVERFLOW_BLOCK, UART_OVERFLOW_DROP_NEWEST, UART_OVERFLOW_DROP_OLDEST or UART_OVERFLOW_DROP_MESSAGE.
+         * @return 0 on success, 1 if the message has not been queued completely.
+         *
+         * @details
+         * Same as uart_write(), the policy only applies to this message and the policy of uart_tx_overflow() stays untouched.
+         */
+        char uart_write_policy(const char *data, unsigned char length, unsigned char policy)
+        {
+            unsigned char start;
+            unsigned char reserved = uart_tx_reserve_space(length, &start, 0, policy);
+
+            if (!reserved)
+            {
+                return length ? 1 : 0;
+            }
+
+            for (unsigned char i = 0; i < reserved; i++)
+            {
+                uart_tx_buffer[(start + i) & UART_TX_BUFFER_MASK] = data[i];
+            }
+            uart_tx_commit_space();
+
+            if (reserved != length)
+            {
+                return 1;
+            }
+            return 0;
+        }
+    #endif
+
+    /**
+     * @brief Check and clear the transmit activity.
+     *
+     * @return 1 if a character has been written to UDR since the last call, otherwise 0.
+     *
+     * @details
+     * Covers all transmit paths (uart_putchar(), uart_write(), frames, streams), e.g. for link supervision that only sends heartbeats on an idle line.
+     */
+    unsigned char uart_tx_active(void)
+    {
+        unsigned char active;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            active = uart_tx_activity;
+            uart_tx_activity = 0;
+        }
+        return active;
+    }
+
+    /**
+     * @brief Wait until all queued characters have left the transmit shift register.
+     *
+     * @details
+     * Use before uart_disable(), sleep modes or clock changes. Must be called with interrupts enabled in buffered mode.
+     */
+    void uart_flush(void)
+    {
+        #if UART_RTOS > 0
+            unsigned char blocking = uart_rtos_blocking(SREG & (1<<SREG_I));
+
+            while (blocking)
+            {
+                unsigned char idle;
+
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                {
+                    idle = !uart_tx_writers && (uart_tx_tail == uart_tx_commit);
+
+                    if (!idle)
+                    {
+                        // Only the empty queue wakes this waiter, unless a producer needs less
+                        if (!uart_tx_waiting)
+                        {
+                            uart_tx_needed = UART_TX_BUFFER_MASK;
+                        }
+                        uart_tx_waiting++;
+                    }
+                }
+
+                if (idle)
+                {
+                    break;
+                }
+                xSemaphoreTake(uart_tx_semaphore, portMAX_DELAY);
+            }
+        #endif
+
+        #if UART_TX_BUFFER_SIZE > 0
+            // Wait until all producers committed and the ISR drained the queue
+            while (uart_tx_writers || (uart_tx_tail != uart_tx_commit))
+            {
+                #if UART_HANDSHAKE == 2
+                    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                    {
+                        uart_tx_resume();
+                    }
+                #endif
+            }
+        #endif
+
+        #if UART_DITHER > 0
+            // TXC is cleared by ISR(UART_TXC_vect), which disables itself when the line is idle
+            while (UCSRB & (1<<TXCIE))
+            {
+                #if UART_RTOS > 0
+                    if (blocking)
+                    {
+                        vTaskDelay(1);
+                    }
+                #endif
+            }
+            uart_tx_sent = 0;
+        #else
+            if (uart_tx_sent)
+            {
+                // At most one character time left, sleep for a scheduler tick instead of spinning
+                while (!(UCSRA & (1<<TXC)))
+                {
+                    #if UART_RTOS > 0
+                        if (blocking)
+                        {
+                            vTaskDelay(1);
+                        }
+                    #endif
+                }
+                uart_tx_sent = 0;
+            }
+        #endif
+    }
     
     #if (UART_STDMODE == 1 || UART_STDMODE == 2)
         /**
@@ -173,10 +2854,19 @@ void uart_disable(void)
          *
          * @details
          * Internal callback used by avr-libc fdevopen() for printf() redirection. Only compiled when UART_STDMODE == 1 or 2 (write support).
+         * With UART_RTOS > 0 the stdio mutex is held from the first character of a line until its newline, so lines of different tasks do not interleave.
          */
         int uart_printf(char data, FILE *stream)
         {
-            return uart_putchar(data);
+            #if UART_RTOS > 0
+                char owner = uart_stdio_begin(uart_stdio_mutex, &uart_stdio_line);
+                int result = uart_putchar(data);
+
+                uart_stdio_end(uart_stdio_mutex, &uart_stdio_line, owner, data);
+                return result;
+            #else
+                return uart_putchar(data);
+            #endif
         }
     #endif
 
@@ -191,45 +2881,102 @@ void uart_disable(void)
      *
      * @details
      * Checks RXCIF flag and validates frame using uart_error_flags(). Handles XON/XOFF software handshake if enabled. Echoes received data if UART_RXC_ECHO defined.
+     * With UART_RX_BUFFER_SIZE > 0 the byte is taken from the receive queue instead (handshake and echo are handled by the ISR) and a paused remote is resumed at UART_RX_HANDSHAKE_LOW fill level.
      *
      * @note Does NOT block. Returns immediately with status.
      */
     UART_Data uart_scanchar(char *data)
     {
-        // If data has been received
-        if((UCSRA & (1<<RXC)))
-        {
-            // Check if an UART_Error ocurred
-            if(uart_error_flags() != UART_None)
+        #if UART_RX_BUFFER_SIZE > 0
+            unsigned char fill;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
             {
-                UDR;           // Clear UDR0 Data register
-                *data = 0;
-                return UART_Fault;
-            }
-            
-            #if UART_HANDSHAKE == 1
-                if (*data == UART_HANDSHAKE_XON)
+                unsigned char tail = uart_rx_tail;
+                unsigned char next = (tail + 1) & UART_RX_BUFFER_MASK;
+
+                // Report latched receive error first
+                if (uart_rx_error != UART_None)
                 {
-                    uart_handshake_sending = UART_Ready;
-                    return UART_Empty;
-                }                
-                else if (*data == UART_HANDSHAKE_XOFF)
+                    uart_rx_error = UART_None;
+                    *data = 0;
+                    return UART_Fault;
+                }
+
+                if (tail == uart_rx_head)
                 {
-                    uart_handshake_sending = UART_Pause;
                     return UART_Empty;
-                }                
+                }
+
+                *data = uart_rx_buffer[tail];
+
+                // Message start must never fall behind the consumer
+                if (uart_rx_message == tail)
+                {
+                    uart_rx_message = next;
+                }
+                uart_rx_tail = next;
+
+                fill = (uart_rx_head - next) & UART_RX_BUFFER_MASK;
+            }
+
+            #if UART_HANDSHAKE > 0
+                if (uart_rx_paused && fill <= UART_RX_HANDSHAKE_LOW)
+                {
+                    uart_rx_paused = 0;
+                    uart_handshake(UART_Ready);
+                }
+            #else
+                (void)fill;
             #endif
+
+            return UART_Received;
+        #else
+            // If data has been received
+            if((UCSRA & (1<<RXC)))
+            {
+                // Check if an UART_Error ocurred
+                if(uart_error_flags() != UART_None)
+                {
+                    UDR;           // Clear UDR0 Data register
+                    *data = 0;
+                    return UART_Fault;
+                }
             
-            *data = UDR;
+                #if UART_HANDSHAKE == 1
+                    if (*data == UART_HANDSHAKE_XON)
+                    {
+                        uart_handshake_sending = UART_Ready;
+
+                        #if UART_TX_BUFFER_SIZE > 0
+                            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                            {
+                                if (uart_tx_tail != uart_tx_commit)
+                                {
+                                    uart_tx_start();
+                                }
+                            }
+                        #endif
+                        return UART_Empty;
+                    }                
+                    else if (*data == UART_HANDSHAKE_XOFF)
+                    {
+                        uart_handshake_sending = UART_Pause;
+                        return UART_Empty;
+                    }                
+                #endif
             
-            #if defined(UART_RXC_ECHO) && !defined(UART_TXCIE) && !defined(UART_UDRIE)
-                // Send echo of received data to UART
-                uart_putchar(*data);
-            #endif
+                *data = UDR;
             
-            return UART_Received;
-        }
-        return UART_Empty;
+                #if defined(UART_RXC_ECHO) && !defined(UART_TXCIE) && !defined(UART_UDRIE)
+                    // Send echo of received data to UART
+                    uart_putchar(*data);
+                #endif
+            
+                return UART_Received;
+            }
+            return UART_Empty;
+        #endif
     }
 
     /**
@@ -240,6 +2987,7 @@ void uart_disable(void)
      *
      * @details
      * Loops calling uart_scanchar() until data available or error occurs. Status indicates if data valid (UART_Received) or error (UART_Fault).
+     * With UART_RTOS > 0 the calling task blocks on a semaphore given by the receive ISR instead of polling (once the scheduler runs).
      */
     char uart_getchar(UART_Data *status)
     {
@@ -250,12 +2998,80 @@ void uart_disable(void)
         do
         {
             temp = uart_scanchar(&data);
+
+            #if UART_RTOS > 0
+                if (temp == UART_Empty && uart_rtos_blocking(SREG & (1<<SREG_I)))
+                {
+                    unsigned char empty;
+
+                    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                    {
+                        empty = (uart_rx_head == uart_rx_tail) && (uart_rx_error == UART_None);
+
+                        if (empty)
+                        {
+                            uart_rx_waiting++;
+                        }
+                    }
+
+                    if (empty)
+                    {
+                        xSemaphoreTake(uart_rx_semaphore, portMAX_DELAY);
+                    }
+                }
+            #endif
         } while (temp == UART_Empty);
         
         *status = temp;
         return data;
     }
     
+    /**
+     * @brief Check and clear UART receive error flags.
+     *
+     * @return UART_Error code: UART_None, UART_Frame, UART_Overrun, or UART_Parity.
+     *
+     * @details
+     * Reads RXDATAH error bits (FERR, BUFOVF, PERR) and clears by reading RXDATAL. Returns first detected error or UART_None if no errors.
+     * With UART_RX_BUFFER_SIZE > 0 the error latched by the receive ISR is returned and cleared.
+     */
+    UART_Error uart_error_flags(void)
+    {
+        #if UART_RX_BUFFER_SIZE > 0
+            UART_Error error;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                error = uart_rx_error;
+                uart_rx_error = UART_None;
+            }
+            return error;
+        #else
+            // UART_Frame error
+            if(UCSRA & (1<<FE))
+            {
+                UDR;           // Clear UART data register
+                return UART_Frame;   // Return NUL
+            }
+            // Data UART_Overrun error
+            else if(UCSRA & (1<<DOR))
+            {
+                UDR;           // Clear UART data register
+                return UART_Overrun; // Return NUL
+            }
+            // UART_Parity error
+            // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+            // !!!ON megaDFP < 2 UPE is just PE!!!
+            // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+            else if(UCSRA & (1<<UPE))
+            {
+                UDR;           // Clear UART data register
+                return UART_Parity;  // Return NUL
+            }
+            return UART_None;
+        #endif
+    }
+
     #if (UART_STDMODE == 1 || UART_STDMODE == 3)
         /**
          * @brief UART scanf stream handler for stdin redirection.
@@ -265,10 +3081,19 @@ void uart_disable(void)
          *
          * @details
          * Internal callback used by avr-libc fdevopen() for scanf() redirection. Only compiled when UART_STDMODE == 1 or 3 (read support).
+         * With UART_RTOS > 0 an input line belongs to one task, a separate mutex is held until its newline has been read. Output of other tasks is not blocked meanwhile.
          */
         int uart_scanf(FILE *stream)
         {
-            return (int)uart_getchar(NULL);
+            #if UART_RTOS > 0
+                char owner = uart_stdio_begin(uart_stdin_mutex, &uart_stdin_line);
+                char data = uart_getchar(NULL);
+
+                uart_stdio_end(uart_stdin_mutex, &uart_stdin_line, owner, data);
+                return (int)data;
+            #else
+                return (int)uart_getchar(NULL);
+            #endif
         }
 
         /**
@@ -282,40 +3107,7 @@ void uart_disable(void)
             clearerr(stdin);    // Clear error on stream
             getchar();          // Remove character from stream
         }
-		
-		/**
-		 * @brief Check and clear UART receive error flags.
-		 *
-		 * @return UART_Error code: UART_None, UART_Frame, UART_Overrun, or UART_Parity.
-		 *
-		 * @details
-		 * Reads RXDATAH error bits (FERR, BUFOVF, PERR) and clears by reading RXDATAL. Returns first detected error or UART_None if no errors.
-		 */
-		UART_Error uart_error_flags(void)
-		{
-			// UART_Frame error
-			if(UCSRA & (1<<FE))
-			{
-				UDR;           // Clear UART data register
-				return UART_Frame;   // Return NUL
-			}
-			// Data UART_Overrun error
-			else if(UCSRA & (1<<DOR))
-			{
-				UDR;           // Clear UART data register
-				return UART_Overrun; // Return NUL
-			}
-			// UART_Parity error
-			// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-			// !!!ON megaDFP < 2 UPE is just PE!!!
-			// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-			else if(UCSRA & (1<<UPE))
-			{
-				UDR;           // Clear UART data register
-				return UART_Parity;  // Return NUL
-			}
-			return UART_None;
-		}
+
     #endif
 
 #endif
@@ -338,7 +3130,9 @@ void uart_disable(void)
 		{
 			if(status == UART_Ready)
 			{
-				#if UART_HANDSHAKE == 1
+				#if UART_HANDSHAKE == 1 && UART_TX_BUFFER_SIZE > 0
+					uart_tx_control_send(UART_HANDSHAKE_XON);
+				#elif UART_HANDSHAKE == 1
 					uart_putchar(UART_HANDSHAKE_XON);
 				#elif UART_HANDSHAKE == 2
 					UART_HANDSHAKE_PORT &= ~(1<<UART_HANDSHAKE_RTS_PIN);
@@ -346,7 +3140,9 @@ void uart_disable(void)
 			}
 			else if(status == UART_Pause)
 			{
-				#if UART_HANDSHAKE == 1
+				#if UART_HANDSHAKE == 1 && UART_TX_BUFFER_SIZE > 0
+					uart_tx_control_send(UART_HANDSHAKE_XOFF);
+				#elif UART_HANDSHAKE == 1
 					uart_putchar(UART_HANDSHAKE_XOFF);
 				#elif UART_HANDSHAKE == 2
 					UART_HANDSHAKE_PORT |= (1<<UART_HANDSHAKE_RTS_PIN);
@@ -96,6 +96,64 @@
         #define UART_STOPBITS 1
     #endif
 
+    #ifndef UART_MODE
+        /**
+         * @def UART_MODE
+         * @brief Operating mode of the USART.
+         *
+         * @details
+         * - 0 = Asynchronous UART (default)
+         * - 1 = Master SPI Mode (MSPIM), see UART_SPI_MODE, UART_SPI_ORDER and UART_SPI_UBRR
+         *
+         * In MSPIM the USART drives XCK as SPI clock, TXD as MOSI and samples RXD as MISO. The transmitter stays double buffered, so uart_spi_transfer() streams bytes without gap between them.
+         *
+         * @attention MSPIM is only available on devices that provide UMSEL1/UMSEL0 (e.g. ATtiny2313A/4313). Buffered modes, calibration, clock switching and dithering are not available in MSPIM.
+         */
+        #define UART_MODE 0
+    #endif
+
+    #if UART_MODE == 1
+        #ifndef UART_SPI_MODE
+            /**
+             * @def UART_SPI_MODE
+             * @brief SPI data mode 0-3 (bit 1 = CPOL, bit 0 = CPHA, default 0).
+             */
+            #define UART_SPI_MODE 0
+        #endif
+
+        #ifndef UART_SPI_ORDER
+            /**
+             * @def UART_SPI_ORDER
+             * @brief Bit order (0 = MSB first, default; 1 = LSB first).
+             */
+            #define UART_SPI_ORDER 0
+        #endif
+
+        #ifndef UART_SPI_UBRR
+            /**
+             * @def UART_SPI_UBRR
+             * @brief SPI clock divider, f(SCK) = F_CPU / (2 * (UART_SPI_UBRR + 1)) (default 0 = F_CPU/2).
+             */
+            #define UART_SPI_UBRR 0
+        #endif
+
+        #ifndef UART_SPI_XCK_DDR
+            /**
+             * @def UART_SPI_XCK_DDR
+             * @brief DDR register of the XCK (SPI clock) pin.
+             */
+            #define UART_SPI_XCK_DDR DDRD
+        #endif
+
+        #ifndef UART_SPI_XCK_PIN
+            /**
+             * @def UART_SPI_XCK_PIN
+             * @brief Bit number of the XCK (SPI clock) pin.
+             */
+            #define UART_SPI_XCK_PIN PD2
+        #endif
+    #endif
+
     #ifndef UART_RXC_ECHO
         /**
          * @def UART_RXC_ECHO
@@ -124,74 +182,76 @@
          * - 1 = Software flow control (XON/XOFF)
          * - 2 = Hardware flow control (RTS/CTS)
          *
+         * With UART_TX_BUFFER_SIZE > 0 the local XON/XOFF is sent ahead of the transmit queue, and a remote XOFF or an inactive CTS stops the queue. CTS has no interrupt, the queue resumes with the next write, while a producer or uart_flush() waits and in uart_tick().
+         *
          * @note Enables reliable data transfer when receiver buffer overflows.
          */
         #define UART_HANDSHAKE 0
+    #endif
+	
+    #if UART_HANDSHAKE == 2
+        /**
+         * @def UART_HANDSHAKE_DDR
+         * @brief DDR direction register for hardware handshake pins (RTS/CTS).
+         */
+        #ifndef UART_HANDSHAKE_DDR
+            #define UART_HANDSHAKE_DDR DDRC
+        #endif
 		
-        #if UART_HANDSHAKE == 2
-            /**
-             * @def UART_HANDSHAKE_DDR
-             * @brief DDR direction register for hardware handshake pins (RTS/CTS).
-             */
-            #ifndef UART_HANDSHAKE_DDR
-                #define UART_HANDSHAKE_DDR DDRC
-            #endif
-			
-            /**
-             * @def UART_HANDSHAKE_PIN
-             * @brief PIN register for hardware handshake pins (RTS/CTS).
-             */
-            #ifndef UART_HANDSHAKE_PIN
-                #define UART_HANDSHAKE_PIN PINC
-            #endif
-
-            /**
-             * @def UART_HANDSHAKE_PORT
-             * @brief PORT register for hardware handshake pins (RTS/CTS).
-             */
-            #ifndef UART_HANDSHAKE_PORT
-                #define UART_HANDSHAKE_PORT PORTC
-            #endif
-
-            /**
-             * @def UART_HANDSHAKE_CTS_PIN
-             * @brief Clear To Send input pin bitmask.
-             *
-             * @details
-             * CTS pin signals when remote device is ready to receive data. Transmission pauses when CTS is inactive (low).
-             */
-            #ifndef UART_HANDSHAKE_CTS_PIN
-                #define UART_HANDSHAKE_CTS_PIN  PINC0
-            #endif
-
-            /**
-             * @def UART_HANDSHAKE_RTS_PIN
-             * @brief Request To Send output pin bitmask.
-             *
-             * @details
-             * RTS pin signals to remote device that local receiver is ready. Set active (high) when buffer has space.
-             */
-            #ifndef UART_HANDSHAKE_RTS_PIN
-                #define UART_HANDSHAKE_RTS_PIN  PINC1
-            #endif
+        /**
+         * @def UART_HANDSHAKE_PIN
+         * @brief PIN register for hardware handshake pins (RTS/CTS).
+         */
+        #ifndef UART_HANDSHAKE_PIN
+            #define UART_HANDSHAKE_PIN PINC
+        #endif
 
+        /**
+         * @def UART_HANDSHAKE_PORT
+         * @brief PORT register for hardware handshake pins (RTS/CTS).
+         */
+        #ifndef UART_HANDSHAKE_PORT
+            #define UART_HANDSHAKE_PORT PORTC
         #endif
 
-        #ifndef UART_HANDSHAKE_XON
-            /**
-             * @def UART_HANDSHAKE_XON
-             * @brief XON character (transmit when ready to receive).
-             */
-            #define UART_HANDSHAKE_XON 0x11
+        /**
+         * @def UART_HANDSHAKE_CTS_PIN
+         * @brief Clear To Send input pin bitmask.
+         *
+         * @details
+         * CTS pin signals when remote device is ready to receive data. Transmission pauses when CTS is inactive (low).
+         */
+        #ifndef UART_HANDSHAKE_CTS_PIN
+            #define UART_HANDSHAKE_CTS_PIN  PINC0
         #endif
-        
-        #ifndef UART_HANDSHAKE_XOFF
-            /**
-             * @def UART_HANDSHAKE_XOFF
-             * @brief XOFF character (transmit when not ready to receive).
-             */
-            #define UART_HANDSHAKE_XOFF 0x13
+
+        /**
+         * @def UART_HANDSHAKE_RTS_PIN
+         * @brief Request To Send output pin bitmask.
+         *
+         * @details
+         * RTS pin signals to remote device that local receiver is ready. Set active (high) when buffer has space.
+         */
+        #ifndef UART_HANDSHAKE_RTS_PIN
+            #define UART_HANDSHAKE_RTS_PIN  PINC1
         #endif
+
+    #endif
+
+    #ifndef UART_HANDSHAKE_XON
+        /**
+         * @def UART_HANDSHAKE_XON
+         * @brief XON character (transmit when ready to receive).
+         */
+        #define UART_HANDSHAKE_XON 0x11
+    #endif
+    
+    #ifndef UART_HANDSHAKE_XOFF
+        /**
+         * @def UART_HANDSHAKE_XOFF
+         * @brief XOFF character (transmit when not ready to receive).
+         */
+        #define UART_HANDSHAKE_XOFF 0x13
     #endif
 
     #ifndef UART_STDMODE
@@ -218,6 +278,7 @@
      * @attention 
      * !!! Interrupts are NOT implemented in this library !!!
      * If interrupts are used, polling functions will be disabled. Users must implement ISR handlers separately.
+     * The buffered modes (see @ref UART_Buffering) are the exception, their ISR handlers are part of this library.
      */
     /* @{ */
     #ifndef UART_RXCIE
@@ -270,38 +331,1019 @@
     #endif
     /* @} */
 
-	#include <stdio.h>
-	#include <avr/io.h>
-	#include <util/setbaud.h>
+    /**
+     * @defgroup UART_Buffering UART Buffered Transmission/Reception Macros
+     * @brief Configuration macros for the interrupt driven queues of this library.
+     *
+     * @details
+     * In contrast to UART_RXCIE/UART_TXCIE/UART_UDRIE, the buffered modes implement their ISR handlers inside this library. The polling API (uart_putchar(), uart_printf(), ...) remains available and operates on the queues.
+     */
+    /* @{ */
+    #ifndef UART_TX_BUFFER_SIZE
+        /**
+         * @def UART_TX_BUFFER_SIZE
+         * @brief Size of the interrupt driven transmit queue in bytes.
+         *
+         * @details
+         * - 0 = Disabled, uart_putchar() polls UDRE (default)
+         * - 2, 4, 8, ..., 256 = Transmit queue drained by ISR(UART_UDRE_vect)
+         *
+         * The queue accepts multiple producers (main loop and ISRs). Every producer reserves its space in a short critical section and copies its data with interrupts enabled. Data becomes visible to the transmitter only when all open reservations are committed, so each uart_write() message lands contiguously on the wire.
+         *
+         * @note The usable capacity is UART_TX_BUFFER_SIZE - 1 bytes.
+         * @attention Cannot be combined with UART_TXCIE or UART_UDRIE.
+         */
+        #define UART_TX_BUFFER_SIZE 0
+    #endif
 
-	#include "../common/enums/UART_enums.h"
+    #if UART_TX_BUFFER_SIZE > 0
+        #if defined(UART_TXCIE) || defined(UART_UDRIE)
+            #error "UART_TX_BUFFER_SIZE cannot be used together with UART_TXCIE or UART_UDRIE"
+        #endif
 
-	void uart_init(void);
-	void uart_disable(void);
+        #if (UART_TX_BUFFER_SIZE > 256) || (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1))
+            #error "UART_TX_BUFFER_SIZE has to be a power of two (2-256)"
+        #endif
 
-	#if !defined(UART_TXCIE) && !defined(UART_UDRIE)
-		char uart_putchar(char data);
-	
-		#if UART_STDMODE == 1 || UART_STDMODE == 2
-			int uart_printf(char data, FILE *stream);
-		#endif
-	#endif
+        #ifndef UART_UDRE_vect
+            /**
+             * @def UART_UDRE_vect
+             * @brief Interrupt vector used for the transmit queue (Data Register Empty).
+             */
+            #define UART_UDRE_vect USART_UDRE_vect
+        #endif
+    #endif
 
-	#if !defined(UART_RXCIE)
-			 char uart_getchar(UART_Data *status);
-		UART_Data uart_scanchar(char *data);
-		UART_Error uart_error_flags(void);
-        
-		#if UART_STDMODE == 1 || UART_STDMODE == 3
-				 int uart_scanf(FILE *stream);
-				void uart_clear(void);
-		#endif
-	#endif
+    #ifndef UART_TICK_HZ
+        /**
+         * @def UART_TICK_HZ
+         * @brief Call rate of uart_tick() in Hz (default 1000).
+         *
+         * @details
+         * Timed features (transmit pacing, receive coalescing, transmit coalescing, frame receive timeout) do not occupy a timer of their own. The application calls uart_tick() from an existing periodic timer ISR at this rate.
+         */
+        #define UART_TICK_HZ 1000UL
+    #endif
 
-	#if !defined(UART_TXCIE) && !defined(UART_UDRIE) && !defined(UART_RXCIE)
-		#if UART_HANDSHAKE > 0
-			UART_Handshake uart_handshake(UART_Handshake status);
-		#endif
+    /**
+     * @def UART_TICK_CHARACTERS
+     * @brief Converts n character times to uart_tick() periods.
+     *
+     * @details
+     * Rounded up, one additional tick compensates the unknown phase of the tick to the last character.
+     */
+    #define UART_TICK_CHARACTERS(n) (((((n) * (1UL + UART_DATASIZE + (UART_PARITY ? 1UL : 0UL) + UART_STOPBITS) * UART_TICK_HZ) + UART_BAUDRATE - 1UL) / UART_BAUDRATE) + 1UL)
+
+    #ifndef UART_TX_PACING
+        /**
+         * @def UART_TX_PACING
+         * @brief Transmit rate limiting with a token bucket (0 = disabled, default; 1 = enabled).
+         *
+         * @details
+         * Every transmitted character consumes a token. uart_tick() refills UART_TX_PACING_RATE tokens per second up to UART_TX_PACING_BURST, the transmit ISR pauses while the bucket is empty. No CPU time is spent in delay loops.
+         *
+         * @attention Requires UART_TX_BUFFER_SIZE > 0 and uart_tick().
+         */
+        #define UART_TX_PACING 0
+    #endif
+
+    #if UART_TX_PACING > 0
+        #if UART_TX_BUFFER_SIZE == 0
+            #error "UART_TX_PACING requires UART_TX_BUFFER_SIZE > 0"
+        #endif
+
+        #ifndef UART_TX_PACING_RATE
+            /**
+             * @def UART_TX_PACING_RATE
+             * @brief Sustained transmit rate in bytes per second (default: line rate of 10 bit frames).
+             */
+            #define UART_TX_PACING_RATE (UART_BAUDRATE / 10UL)
+        #endif
+
+        #ifndef UART_TX_PACING_BURST
+            /**
+             * @def UART_TX_PACING_BURST
+             * @brief Token bucket size, maximum number of back-to-back characters (1-255, default 16).
+             */
+            #define UART_TX_PACING_BURST 16
+        #endif
+
+        #ifndef UART_TX_PACING_GAP
+            /**
+             * @def UART_TX_PACING_GAP
+             * @brief Minimum idle time between two character frames in uart_tick() periods (0 = disabled, default).
+             */
+            #define UART_TX_PACING_GAP 0
+        #endif
+
+        #if UART_TX_PACING_BURST < 1 || UART_TX_PACING_BURST > 255
+            #error "UART_TX_PACING_BURST has to be 1-255"
+        #endif
+    #endif
+
+    #ifndef UART_RX_BUFFER_SIZE
+        /**
+         * @def UART_RX_BUFFER_SIZE
+         * @brief Size of the interrupt driven receive queue in bytes.
+         *
+         * @details
+         * - 0 = Disabled, uart_scanchar() polls RXC (default)
+         * - 2, 4, 8, ..., 256 = Receive queue filled by ISR(UART_RXC_vect)
+         *
+         * Receive errors (frame, overrun, parity) are latched by the ISR, the faulty byte is discarded and the next uart_scanchar() returns UART_Fault.
+         *
+         * @note The usable capacity is UART_RX_BUFFER_SIZE - 1 bytes.
+         * @attention Cannot be combined with UART_RXCIE.
+         */
+        #define UART_RX_BUFFER_SIZE 0
+    #endif
+
+    #ifndef UART_DITHER
+        /**
+         * @def UART_DITHER
+         * @brief Fractional transmit baud rate by UBRR dithering (0 = disabled, default; 1 = enabled).
+         *
+         * @details
+         * The ideal divider F_CPU/(UART_DITHER_SAMPLES*UART_BAUDRATE) is mostly not an integer. With dithering, every character is sent with either the lower or the upper adjacent UBRR, chosen by an error accumulator, so the long-run bit rate averages to UART_BAUDRATE. UBRR is changed in ISR(UART_TXC_vect) while the line is idle, which costs the transmit double buffering (one ISR latency between characters).
+         *
+         * The compile time report is given by UART_DITHER_ERROR_LOW/UART_DITHER_ERROR_HIGH (per-frame error of both dividers in per mille), a warning is issued if one of them exceeds UART_DITHER_LIMIT. The per-frame error still has to be tolerated by the remote receiver, which resynchronizes on every start bit.
+         *
+         * @attention Requires UART_TX_BUFFER_SIZE > 0. The receiver shares the baud rate generator, dithering is meant for transmit-only or half-duplex links. Cannot be combined with UART_CLOCK or UART_CALIBRATION 2, which change UBRR at runtime.
+         */
+        #define UART_DITHER 0
+    #endif
+
+    #if UART_DITHER > 0
+        #if UART_TX_BUFFER_SIZE == 0
+            #error "UART_DITHER requires UART_TX_BUFFER_SIZE > 0"
+        #endif
+
+        #ifndef UART_DITHER_SAMPLES
+            /**
+             * @def UART_DITHER_SAMPLES
+             * @brief Samples per bit while dithering (16 = normal speed, 8 = U2X).
+             */
+            #define UART_DITHER_SAMPLES 16
+        #endif
+
+        #ifndef UART_DITHER_LIMIT
+            /**
+             * @def UART_DITHER_LIMIT
+             * @brief Per-frame baud rate error in per mille that triggers a compile time warning (default 2%).
+             */
+            #define UART_DITHER_LIMIT 20
+        #endif
+
+        #ifndef UART_TXC_vect
+            /**
+             * @def UART_TXC_vect
+             * @brief Interrupt vector used for dithering (Transmit Complete).
+             */
+            #define UART_TXC_vect USART_TXC_vect
+        #endif
+
+        /**
+         * @def UART_DITHER_DENOMINATOR
+         * @brief Denominator of the ideal divider (UART_DITHER_SAMPLES * UART_BAUDRATE).
+         */
+        #define UART_DITHER_DENOMINATOR (UART_DITHER_SAMPLES * 1UL * UART_BAUDRATE)
+
+        /**
+         * @def UART_DITHER_UBRR
+         * @brief Lower UBRR, the upper one is UART_DITHER_UBRR + 1.
+         */
+        #define UART_DITHER_UBRR ((F_CPU / UART_DITHER_DENOMINATOR) - 1)
+
+        /**
+         * @def UART_DITHER_FRACTION
+         * @brief Numerator of the fractional divider part, share of characters sent with the upper UBRR.
+         */
+        #define UART_DITHER_FRACTION (F_CPU % UART_DITHER_DENOMINATOR)
+
+        /**
+         * @def UART_DITHER_ERROR_LOW
+         * @brief Per-frame error of the lower UBRR in per mille (bit rate too high).
+         */
+        #define UART_DITHER_ERROR_LOW ((((F_CPU * 1000ULL) / (UART_DITHER_SAMPLES * (UART_DITHER_UBRR + 1ULL))) - (UART_BAUDRATE * 1000ULL)) / UART_BAUDRATE)
+
+        /**
+         * @def UART_DITHER_ERROR_HIGH
+         * @brief Per-frame error of the upper UBRR in per mille (bit rate too low, 0 if not used).
+         */
+        #define UART_DITHER_ERROR_HIGH (UART_DITHER_FRACTION ? (((UART_BAUDRATE * 1000ULL) - ((F_CPU * 1000ULL) / (UART_DITHER_SAMPLES * (UART_DITHER_UBRR + 2ULL)))) / UART_BAUDRATE) : 0)
+
+        #if (F_CPU / UART_DITHER_DENOMINATOR) < 1 || UART_DITHER_UBRR > 4094
+            #error "UART_DITHER: UART_BAUDRATE not reachable with F_CPU"
+        #endif
+
+        #if UART_DITHER_ERROR_LOW > UART_DITHER_LIMIT || UART_DITHER_ERROR_HIGH > UART_DITHER_LIMIT
+            #warning "UART_DITHER: per-frame baud rate error of a dithered divider exceeds UART_DITHER_LIMIT"
+        #endif
+    #endif
+
+    #if UART_RX_BUFFER_SIZE > 0
+        #if defined(UART_RXCIE)
+            #error "UART_RX_BUFFER_SIZE cannot be used together with UART_RXCIE"
+        #endif
+
+        #if (UART_RX_BUFFER_SIZE > 256) || (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1))
+            #error "UART_RX_BUFFER_SIZE has to be a power of two (2-256)"
+        #endif
+
+        #ifndef UART_RXC_vect
+            /**
+             * @def UART_RXC_vect
+             * @brief Interrupt vector used for the receive queue (Receive Complete).
+             */
+            #define UART_RXC_vect USART_RXC_vect
+        #endif
+    #endif
+
+    #ifndef UART_RX_COALESCE
+        /**
+         * @def UART_RX_COALESCE
+         * @brief Receive interrupt moderation (0 = disabled, default; 1 = enabled).
+         *
+         * @details
+         * The consumer is signalled only when UART_RX_COALESCE_COUNT bytes have been received or the line has been idle for UART_RX_COALESCE_TIMEOUT character times after the last byte. The signal is a callback (uart_rx_notify()) called from ISR context and/or the polled flag of uart_rx_ready().
+         *
+         * @attention Requires UART_RX_BUFFER_SIZE > 0 and uart_tick().
+         */
+        #define UART_RX_COALESCE 0
+    #endif
+
+    #if UART_RX_COALESCE > 0
+        #if UART_RX_BUFFER_SIZE == 0
+            #error "UART_RX_COALESCE requires UART_RX_BUFFER_SIZE > 0"
+        #endif
+
+        #ifndef UART_RX_COALESCE_COUNT
+            /**
+             * @def UART_RX_COALESCE_COUNT
+             * @brief Number of received bytes that signal the consumer immediately (default: half of the receive queue).
+             */
+            #define UART_RX_COALESCE_COUNT (UART_RX_BUFFER_SIZE / 2)
+        #endif
+
+        #ifndef UART_RX_COALESCE_TIMEOUT
+            /**
+             * @def UART_RX_COALESCE_TIMEOUT
+             * @brief Idle time in character times after the last byte that signals the consumer (default 4).
+             */
+            #define UART_RX_COALESCE_TIMEOUT 4
+        #endif
+
+        /**
+         * @def UART_RX_COALESCE_TICKS
+         * @brief UART_RX_COALESCE_TIMEOUT converted to uart_tick() periods.
+         */
+        #define UART_RX_COALESCE_TICKS UART_TICK_CHARACTERS(UART_RX_COALESCE_TIMEOUT)
+
+        #if UART_RX_COALESCE_TICKS > 255
+            #error "UART_RX_COALESCE_TIMEOUT is too long for UART_TICK_HZ"
+        #endif
+    #endif
+
+    /**
+     * @def UART_OVERFLOW_BLOCK
+     * @brief Overflow policy: wait until the queue has space.
+     *
+     * @details
+     * Transmit: the producer waits (see uart_write()). Receive: the ISR cannot wait, the remote is paused with uart_handshake() at UART_RX_HANDSHAKE_HIGH fill level (UART_HANDSHAKE > 0) and bytes that still arrive on a full queue are discarded.
+     */
+    #define UART_OVERFLOW_BLOCK 0
+
+    /**
+     * @def UART_OVERFLOW_DROP_NEWEST
+     * @brief Overflow policy: discard the bytes that do not fit anymore.
+     *
+     * @details
+     * Transmit messages are truncated to the free space, received bytes are discarded.
+     */
+    #define UART_OVERFLOW_DROP_NEWEST 1
+
+    /**
+     * @def UART_OVERFLOW_DROP_OLDEST
+     * @brief Overflow policy: overwrite the oldest queued bytes.
+     */
+    #define UART_OVERFLOW_DROP_OLDEST 2
+
+    /**
+     * @def UART_OVERFLOW_DROP_MESSAGE
+     * @brief Overflow policy: discard the whole message.
+     *
+     * @details
+     * Transmit: a uart_write() message that does not fit is discarded completely. Receive: the partially received message is removed from the queue and the following bytes are discarded up to and including the next UART_RX_MESSAGE_DELIMITER.
+     */
+    #define UART_OVERFLOW_DROP_MESSAGE 3
+
+    #if UART_TX_BUFFER_SIZE > 0
+        #ifndef UART_TX_OVERFLOW
+            /**
+             * @def UART_TX_OVERFLOW
+             * @brief Initial overflow policy of the transmit queue (default: UART_OVERFLOW_BLOCK).
+             *
+             * @note Can be changed at runtime with uart_tx_overflow().
+             */
+            #define UART_TX_OVERFLOW UART_OVERFLOW_BLOCK
+        #endif
+    #endif
+
+    #if UART_RX_BUFFER_SIZE > 0
+        #ifndef UART_RX_OVERFLOW
+            /**
+             * @def UART_RX_OVERFLOW
+             * @brief Initial overflow policy of the receive queue (default: UART_OVERFLOW_BLOCK).
+             *
+             * @note Can be changed at runtime with uart_rx_overflow().
+             */
+            #define UART_RX_OVERFLOW UART_OVERFLOW_BLOCK
+        #endif
+
+        #ifndef UART_RX_MESSAGE_DELIMITER
+            /**
+             * @def UART_RX_MESSAGE_DELIMITER
+             * @brief Character that terminates a received message (UART_OVERFLOW_DROP_MESSAGE).
+             */
+            #define UART_RX_MESSAGE_DELIMITER '\n'
+        #endif
+
+        #ifndef UART_RX_HANDSHAKE_HIGH
+            /**
+             * @def UART_RX_HANDSHAKE_HIGH
+             * @brief Receive queue fill level that pauses the remote (UART_OVERFLOW_BLOCK, UART_HANDSHAKE > 0).
+             */
+            #define UART_RX_HANDSHAKE_HIGH ((UART_RX_BUFFER_SIZE * 3) / 4)
+        #endif
+
+        #ifndef UART_RX_HANDSHAKE_LOW
+            /**
+             * @def UART_RX_HANDSHAKE_LOW
+             * @brief Receive queue fill level that resumes the remote (UART_OVERFLOW_BLOCK, UART_HANDSHAKE > 0).
+             */
+            #define UART_RX_HANDSHAKE_LOW (UART_RX_BUFFER_SIZE / 4)
+        #endif
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Calibration UART Clock Calibration Macros
+     * @brief Configuration macros for the calibration against received sync characters.
+     *
+     * @details
+     * Boards running from the internal RC oscillator drift with temperature and voltage until F_CPU does no longer match. uart_calibrate() measures the bit time of received sync characters (0x55) with Timer1 and compares it with the bit time expected from F_CPU and UART_BAUDRATE.
+     */
+    /* @{ */
+    #ifndef UART_CALIBRATION
+        /**
+         * @def UART_CALIBRATION
+         * @brief Calibration mode of uart_calibrate().
+         *
+         * @details
+         * - 0 = Disabled (default)
+         * - 1 = Trim OSCCAL until the measured bit time matches F_CPU/UART_BAUDRATE
+         * - 2 = Keep the clock and adopt UBRR to the measured bit time
+         *
+         * @attention Timer1 is used during calibration and restored afterwards.
+         */
+        #define UART_CALIBRATION 0
+    #endif
+
+    #if UART_CALIBRATION > 0
+        #ifndef UART_CALIBRATION_PIN
+            /**
+             * @def UART_CALIBRATION_PIN
+             * @brief PIN register of the RXD pin.
+             */
+            #define UART_CALIBRATION_PIN PIND
+        #endif
+
+        #ifndef UART_CALIBRATION_RXD
+            /**
+             * @def UART_CALIBRATION_RXD
+             * @brief Bit number of the RXD pin.
+             */
+            #define UART_CALIBRATION_RXD PIND0
+        #endif
+
+        #ifndef UART_CALIBRATION_SAMPLES
+            /**
+             * @def UART_CALIBRATION_SAMPLES
+             * @brief Number of sync characters averaged per measurement.
+             */
+            #define UART_CALIBRATION_SAMPLES 4
+        #endif
+
+        #ifndef UART_CALIBRATION_ITERATIONS
+            /**
+             * @def UART_CALIBRATION_ITERATIONS
+             * @brief Maximum number of OSCCAL trim steps.
+             */
+            #define UART_CALIBRATION_ITERATIONS 32
+        #endif
+
+        #ifndef UART_CALIBRATION_TIMEOUT
+            /**
+             * @def UART_CALIBRATION_TIMEOUT
+             * @brief Number of Timer1 overflows (65536 cycles each) to wait for a sync edge.
+             *
+             * @details
+             * Interrupts are disabled while a sync character is measured, so this is also the worst-case interrupt latency of uart_calibrate(): UART_CALIBRATION_TIMEOUT * 65536 CPU cycles.
+             */
+            #define UART_CALIBRATION_TIMEOUT 64
+        #endif
+
+        /**
+         * @def UART_CALIBRATION_TICKS
+         * @brief Expected duration of 8 bits in CPU cycles.
+         *
+         * @details
+         * A stream of 0x55 characters (start, 10101010, stop) is a continuous 0/1 pattern, so any falling edge to the fourth following falling edge is exactly 8 bit times.
+         */
+        #define UART_CALIBRATION_TICKS ((8UL * F_CPU) / UART_BAUDRATE)
+
+        #ifndef UART_CALIBRATION_TOLERANCE
+            /**
+             * @def UART_CALIBRATION_TOLERANCE
+             * @brief Accepted deviation from UART_CALIBRATION_TICKS in CPU cycles (default 0.5%).
+             */
+            #define UART_CALIBRATION_TOLERANCE ((UART_CALIBRATION_TICKS / 200UL) + 1UL)
+        #endif
+
+        #if UART_CALIBRATION_TICKS > 65535UL
+            #error "UART_CALIBRATION needs 8 bit times below 65536 CPU cycles (increase UART_BAUDRATE)"
+        #endif
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Clock UART Clock Prescaler Macros
+     * @brief Configuration macros for baud rate management on system clock prescaler changes.
+     *
+     * @details
+     * UBRRH_VALUE/UBRRL_VALUE of setbaud.h are only valid for F_CPU. With UART_CLOCK enabled, uart_clock() changes the system clock prescaler (CLKPR) and reprograms UBRR/U2X from a table that is calculated at compile time for every prescaler.
+     */
+    /* @{ */
+    #ifndef UART_CLOCK
+        /**
+         * @def UART_CLOCK
+         * @brief Enables uart_clock() (0 = disabled, default; 1 = enabled).
+         *
+         * @attention Only available on devices with a system clock prescaler (CLKPR).
+         */
+        #define UART_CLOCK 0
+    #endif
+
+    #if UART_CLOCK > 0
+        #ifndef UART_CLOCK_TOLERANCE
+            /**
+             * @def UART_CLOCK_TOLERANCE
+             * @brief Maximum baud rate error in per mille a prescaler is accepted with (default 2%).
+             */
+            #define UART_CLOCK_TOLERANCE 20
+        #endif
+
+        /**
+         * @def UART_CLOCK_UBRR
+         * @brief UBRR for prescaler p (clock F_CPU/2^p) and s samples per bit (16 or 8), clamped to 0.
+         */
+        #define UART_CLOCK_UBRR(p, s) ((((F_CPU >> (p)) + ((s) * UART_BAUDRATE / 2)) / ((s) * UART_BAUDRATE)) > 0 ? ((((F_CPU >> (p)) + ((s) * UART_BAUDRATE / 2)) / ((s) * UART_BAUDRATE)) - 1) : 0)
+
+        /**
+         * @def UART_CLOCK_ERROR
+         * @brief Absolute baud rate error in per mille of UART_CLOCK_UBRR(p, s).
+         */
+        #define UART_CLOCK_ERROR(p, s) (((((F_CPU >> (p)) / ((s) * (UART_CLOCK_UBRR(p, s) + 1))) > UART_BAUDRATE) ? (((F_CPU >> (p)) / ((s) * (UART_CLOCK_UBRR(p, s) + 1))) - UART_BAUDRATE) : (UART_BAUDRATE - ((F_CPU >> (p)) / ((s) * (UART_CLOCK_UBRR(p, s) + 1))))) * 1000UL / UART_BAUDRATE)
+
+        /**
+         * @def UART_CLOCK_ENTRY
+         * @brief Table entry for prescaler p: UBRR (bit 15 = U2X) or 0xFFFF if the baud rate is out of tolerance.
+         *
+         * @details
+         * 16 samples per bit are preferred for their better noise immunity, U2X is only used if the error is too large otherwise.
+         */
+        #define UART_CLOCK_ENTRY(p) ((UART_CLOCK_UBRR(p, 16UL) <= 4095UL && UART_CLOCK_ERROR(p, 16UL) <= UART_CLOCK_TOLERANCE) ? UART_CLOCK_UBRR(p, 16UL) : \
+                                     (UART_CLOCK_UBRR(p, 8UL) <= 4095UL && UART_CLOCK_ERROR(p, 8UL) <= UART_CLOCK_TOLERANCE) ? (UART_CLOCK_UBRR(p, 8UL) | 0x8000UL) : 0xFFFFUL)
+    #endif
+
+    // ISR(UART_TXC_vect) writes the compile time UBRR of the dither accumulator before every character
+    #if UART_DITHER > 0 && (UART_CLOCK > 0 || UART_CALIBRATION == 2)
+        #error "UART_DITHER cannot be combined with UART_CLOCK or UART_CALIBRATION 2, both change UBRR at runtime"
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Framing UART Frame Macros
+     * @brief Configuration macros for length-prefixed binary frames.
+     *
+     * @details
+     * A frame consists of a big-endian length prefix (UART_FRAME_LENGTH_BYTES) with the payload length, the payload and an optional CRC-16/XMODEM (polynomial 0x1021, initial value 0, high byte first) over prefix and payload. Frames are written with uart_frame_write() or streamed with uart_frame_begin()/uart_frame_put()/uart_frame_end(). With the transmit queue a frame is reserved as one message, so frames of concurrent producers never interleave. A frame larger than the free queue (or any frame without transmit queue) is written byte by byte; until it is complete, the messages of other producers are discarded and counted (a blocking RTOS task waits instead).
+     *
+     * With UART_FRAME_RX the receive ISR parses incoming frames and publishes only complete and valid ones (see uart_frame_read()).
+     */
+    /* @{ */
+    #ifndef UART_FRAME
+        /**
+         * @def UART_FRAME
+         * @brief Enables the frame functions (0 = disabled, default; 1 = enabled).
+         */
+        #define UART_FRAME 0
+    #endif
+
+    #if UART_FRAME > 0
+        #ifndef UART_FRAME_LENGTH_BYTES
+            /**
+             * @def UART_FRAME_LENGTH_BYTES
+             * @brief Size of the length prefix in bytes (1 = payload up to 255 bytes, default; 2 = up to 65535 bytes).
+             */
+            #define UART_FRAME_LENGTH_BYTES 1
+        #endif
+
+        #ifndef UART_FRAME_CRC
+            /**
+             * @def UART_FRAME_CRC
+             * @brief Appends a CRC-16/XMODEM to every frame (0 = disabled; 1 = enabled, default).
+             */
+            #define UART_FRAME_CRC 1
+        #endif
+
+        #if defined(UART_TXCIE) || defined(UART_UDRIE)
+            #error "UART_FRAME cannot be used together with UART_TXCIE or UART_UDRIE"
+        #endif
+
+        #if UART_FRAME_LENGTH_BYTES != 1 && UART_FRAME_LENGTH_BYTES != 2
+            #error "UART_FRAME_LENGTH_BYTES has to be 1 or 2"
+        #endif
+
+        /**
+         * @def UART_FRAME_OVERHEAD
+         * @brief Bytes added to the payload of every frame (length prefix and CRC).
+         */
+        #define UART_FRAME_OVERHEAD (UART_FRAME_LENGTH_BYTES + (UART_FRAME_CRC > 0 ? 2 : 0))
+
+        #ifndef UART_FRAME_COALESCE
+            /**
+             * @def UART_FRAME_COALESCE
+             * @brief Coalescing of small frame writes (0 = disabled, default; 1 = enabled).
+             *
+             * @details
+             * uart_frame_write() appends the payload to a pending frame instead of sending it. The pending frame is sent when it reaches UART_FRAME_COALESCE_SIZE bytes, UART_FRAME_COALESCE_DELAY ticks after its first write or with uart_frame_flush(). Many small writes therefore share one length prefix and CRC, the receiver sees their concatenation as one payload.
+             *
+             * @attention Requires UART_TX_BUFFER_SIZE > 0 and uart_tick().
+             */
+            #define UART_FRAME_COALESCE 0
+        #endif
+
+        #if UART_FRAME_COALESCE > 0
+            #if UART_TX_BUFFER_SIZE == 0
+                #error "UART_FRAME_COALESCE requires UART_TX_BUFFER_SIZE > 0"
+            #endif
+
+            #ifndef UART_FRAME_COALESCE_SIZE
+                /**
+                 * @def UART_FRAME_COALESCE_SIZE
+                 * @brief Payload size in bytes that sends the pending frame immediately (default: half of the transmit queue without overhead).
+                 */
+                #define UART_FRAME_COALESCE_SIZE ((UART_TX_BUFFER_SIZE / 2) - UART_FRAME_OVERHEAD)
+            #endif
+
+            #ifndef UART_FRAME_COALESCE_DELAY
+                /**
+                 * @def UART_FRAME_COALESCE_DELAY
+                 * @brief Maximum time in uart_tick() periods a write is held back (default 2).
+                 */
+                #define UART_FRAME_COALESCE_DELAY 2
+            #endif
+
+            #if UART_FRAME_COALESCE_SIZE < 1 || (UART_FRAME_COALESCE_SIZE + UART_FRAME_OVERHEAD) > (UART_TX_BUFFER_SIZE - 1) || (UART_FRAME_COALESCE_SIZE > 255)
+                #error "UART_FRAME_COALESCE_SIZE does not fit into the transmit queue"
+            #endif
+
+            #if UART_FRAME_COALESCE_DELAY < 1 || UART_FRAME_COALESCE_DELAY > 255
+                #error "UART_FRAME_COALESCE_DELAY has to be 1-255"
+            #endif
+        #endif
+
+        #ifndef UART_FRAME_RX
+            /**
+             * @def UART_FRAME_RX
+             * @brief Frame receive mode (0 = disabled, default; 1 = enabled).
+             *
+             * @details
+             * The receive ISR reads the length prefix, collects exactly the announced number of bytes and checks the CRC. Only complete frames become visible in the receive queue, each as length prefix and payload. Frames that are too long (UART_FRAME_RX_MAX), do not fit into the queue, fail the CRC or contain a byte with receive error are discarded and counted (see uart_frame_rejected()).
+             *
+             * @attention Requires UART_RX_BUFFER_SIZE > 0. The receive queue then only holds frames, the byte functions (uart_getchar(), uart_scanchar(), ...) must not be used.
+             */
+            #define UART_FRAME_RX 0
+        #endif
+
+        #if UART_FRAME_RX > 0
+            #if UART_RX_BUFFER_SIZE == 0
+                #error "UART_FRAME_RX requires UART_RX_BUFFER_SIZE > 0"
+            #endif
+
+            #if UART_HANDSHAKE == 1 || UART_RX_COALESCE > 0
+                #error "UART_FRAME_RX cannot be combined with XON/XOFF handshake or UART_RX_COALESCE"
+            #endif
+
+            #ifndef UART_FRAME_RX_MAX
+                /**
+                 * @def UART_FRAME_RX_MAX
+                 * @brief Maximum payload length in bytes, longer frames are discarded (default: receive queue size without length prefix).
+                 */
+                #define UART_FRAME_RX_MAX (UART_RX_BUFFER_SIZE - 1 - UART_FRAME_LENGTH_BYTES)
+            #endif
+
+            #if UART_FRAME_RX_MAX < 1 || UART_FRAME_RX_MAX > (UART_RX_BUFFER_SIZE - 1 - UART_FRAME_LENGTH_BYTES)
+                #error "UART_FRAME_RX_MAX does not fit into the receive queue"
+            #endif
+
+            #ifndef UART_FRAME_RX_TIMEOUT
+                /**
+                 * @def UART_FRAME_RX_TIMEOUT
+                 * @brief Idle time in character times that aborts a partially received frame (0 = disabled, default).
+                 *
+                 * @details
+                 * Resynchronizes the receiver to the next length prefix after a lost byte or a corrupted length.
+                 *
+                 * @attention Requires uart_tick().
+                 */
+                #define UART_FRAME_RX_TIMEOUT 0
+            #endif
+
+            #if UART_FRAME_RX_TIMEOUT > 0
+                /**
+                 * @def UART_FRAME_RX_TICKS
+                 * @brief UART_FRAME_RX_TIMEOUT converted to uart_tick() periods.
+                 */
+                #define UART_FRAME_RX_TICKS UART_TICK_CHARACTERS(UART_FRAME_RX_TIMEOUT)
+
+                #if UART_FRAME_RX_TICKS > 255
+                    #error "UART_FRAME_RX_TIMEOUT is too long for UART_TICK_HZ"
+                #endif
+            #endif
+        #endif
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Streaming UART Streaming Macros
+     * @brief Configuration macros for continuous transmission from a producer.
+     *
+     * @details
+     * Two buffers of UART_STREAM_SIZE bytes are transmitted alternately by ISR(UART_UDRE_vect). While one buffer is on the wire, the producer fills the other one and submits it, so the line stays busy as long as the producer keeps up. A buffer that is not submitted in time is an underrun (see uart_stream_underruns()), the stream continues with the next submitted buffer.
+     *
+     * The producer callback is called from the ISR whenever a buffer has been transmitted. It can fill and submit the free buffer right there (e.g. from an ADC ring buffer) or set a flag for the main loop.
+     *
+     * While a stream is running, the transmit queue is held back, queued data follows after uart_stream_stop().
+     *
+     * @attention Requires UART_TX_BUFFER_SIZE > 0, cannot be combined with UART_DITHER and UART_TX_PACING.
+     */
+    /* @{ */
+    #ifndef UART_STREAM
+        /**
+         * @def UART_STREAM
+         * @brief Streaming from a producer (0 = disabled, default; 1 = enabled).
+         */
+        #define UART_STREAM 0
+    #endif
+
+    #if UART_STREAM > 0
+        #ifndef UART_STREAM_SIZE
+            /**
+             * @def UART_STREAM_SIZE
+             * @brief Size of each of the two stream buffers in bytes (default 32, max 255).
+             *
+             * @details
+             * The producer has the transmission time of one buffer (UART_STREAM_SIZE character times) to submit the next one.
+             */
+            #define UART_STREAM_SIZE 32
+        #endif
+
+        #if UART_STREAM_SIZE < 1 || UART_STREAM_SIZE > 255
+            #error "UART_STREAM_SIZE has to be 1-255"
+        #endif
+
+        #if UART_TX_BUFFER_SIZE == 0
+            #error "UART_STREAM requires UART_TX_BUFFER_SIZE > 0"
+        #endif
+
+        #if UART_DITHER > 0 || UART_TX_PACING > 0
+            #error "UART_STREAM cannot be combined with UART_DITHER or UART_TX_PACING"
+        #endif
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Events UART Event Macros
+     * @brief Configuration macros and types of the event queue.
+     *
+     * @details
+     * Link conditions are queued by the driver as typed events, the application takes them with uart_event_read(). An event of a type that is already queued and not yet read is coalesced into it and only its count grows, so a burst of 37 overruns is one event with count 37 and a storm cannot flood the queue.
+     *
+     * @attention Requires UART_RX_BUFFER_SIZE > 0 (the events are detected by the ISRs).
+     */
+    /* @{ */
+    #ifndef UART_EVENT
+        /**
+         * @def UART_EVENT
+         * @brief Event queue (0 = disabled, default; 1 = enabled).
+         */
+        #define UART_EVENT 0
+    #endif
+
+    #if UART_EVENT > 0
+        #ifndef UART_EVENT_QUEUE_SIZE
+            /**
+             * @def UART_EVENT_QUEUE_SIZE
+             * @brief Size of the event queue, it holds UART_EVENT_QUEUE_SIZE - 1 distinct unread events (default 8, 2-16).
+             *
+             * @details
+             * Every type is queued at most once, with 11 no event is ever lost.
+             */
+            #define UART_EVENT_QUEUE_SIZE 8
+        #endif
+
+        #ifndef UART_EVENT_RX_WATERMARK
+            /**
+             * @def UART_EVENT_RX_WATERMARK
+             * @brief Receive queue fill level that raises UART_EVENT_RX_HIGH (default UART_RX_HANDSHAKE_HIGH).
+             */
+            #define UART_EVENT_RX_WATERMARK UART_RX_HANDSHAKE_HIGH
+        #endif
+
+        #if UART_EVENT_QUEUE_SIZE < 2 || UART_EVENT_QUEUE_SIZE > 16
+            #error "UART_EVENT_QUEUE_SIZE has to be 2-16"
+        #endif
+
+        #if UART_RX_BUFFER_SIZE == 0
+            #error "UART_EVENT requires UART_RX_BUFFER_SIZE > 0"
+        #elif UART_EVENT_RX_WATERMARK < 1 || UART_EVENT_RX_WATERMARK >= UART_RX_BUFFER_SIZE
+            #error "UART_EVENT_RX_WATERMARK has to be 1 - UART_RX_BUFFER_SIZE-1"
+        #endif
+    #endif
+
+    /**
+     * @def UART_EVENT_FRAME
+     * @brief Event: byte received with frame error.
+     */
+    #define UART_EVENT_FRAME 1
+
+    /**
+     * @def UART_EVENT_OVERRUN
+     * @brief Event: receive data overrun (the ISR has been blocked too long).
+     */
+    #define UART_EVENT_OVERRUN 2
+
+    /**
+     * @def UART_EVENT_PARITY
+     * @brief Event: byte received with parity error.
+     */
+    #define UART_EVENT_PARITY 3
+
+    /**
+     * @def UART_EVENT_BREAK
+     * @brief Event: break condition (zero byte with frame error), reported instead of UART_EVENT_FRAME.
+     */
+    #define UART_EVENT_BREAK 4
+
+    /**
+     * @def UART_EVENT_RX_OVERFLOW
+     * @brief Event: received bytes discarded by the receive overflow policy, the count is the number of bytes.
+     */
+    #define UART_EVENT_RX_OVERFLOW 5
+
+    /**
+     * @def UART_EVENT_TX_OVERFLOW
+     * @brief Event: transmit bytes discarded by the transmit overflow policy, the count is the number of discards.
+     */
+    #define UART_EVENT_TX_OVERFLOW 6
+
+    /**
+     * @def UART_EVENT_XON
+     * @brief Event: remote resumed the transmission (UART_HANDSHAKE 1).
+     */
+    #define UART_EVENT_XON 7
+
+    /**
+     * @def UART_EVENT_XOFF
+     * @brief Event: remote paused the transmission (UART_HANDSHAKE 1).
+     */
+    #define UART_EVENT_XOFF 8
+
+    /**
+     * @def UART_EVENT_RX_HIGH
+     * @brief Event: receive queue filled up to UART_EVENT_RX_WATERMARK.
+     */
+    #define UART_EVENT_RX_HIGH 9
+
+    /**
+     * @def UART_EVENT_IDLE
+     * @brief Event: receive line idle for UART_RX_COALESCE_TIMEOUT after data (UART_RX_COALESCE > 0).
+     */
+    #define UART_EVENT_IDLE 10
+    /* @} */
+
+    /**
+     * @defgroup UART_RTOS UART RTOS Integration Macros
+     * @brief Configuration macros for the FreeRTOS integration.
+     *
+     * @details
+     * With UART_RTOS enabled, functions that have to wait (a full transmit queue with UART_OVERFLOW_BLOCK, uart_flush(), uart_getchar() on an empty receive queue) block the calling task on a semaphore instead of spinning. The semaphores are given from the UART ISRs, so a waiting task consumes no CPU time. Before the scheduler is started and with interrupts disabled the functions still poll.
+     *
+     * The stdio stream takes a recursive mutex for every output line (first character until newline), so printf() lines of different tasks never interleave. Input lines are guarded by a separate mutex. uart_lock()/uart_unlock() take the output mutex around a group of lines, output without a newline keeps other tasks waiting until the line is completed. Output with uart_putchar()/uart_write() is not guarded, messages of uart_write() are queued as a whole anyway.
+     *
+     * @attention Requires UART_TX_BUFFER_SIZE > 0, UART_RX_BUFFER_SIZE > 0, FreeRTOS with configUSE_RECURSIVE_MUTEXES, configUSE_COUNTING_SEMAPHORES, INCLUDE_xTaskGetSchedulerState, INCLUDE_xSemaphoreGetMutexHolder and INCLUDE_xTaskGetCurrentTaskHandle. The ISRs give the counting semaphores once per blocked task, every woken task rechecks its condition, and switch to a woken task on exit.
+     */
+    /* @{ */
+    #ifndef UART_RTOS
+        /**
+         * @def UART_RTOS
+         * @brief FreeRTOS integration (0 = disabled, default; 1 = enabled).
+         */
+        #define UART_RTOS 0
+    #endif
+
+    #if UART_RTOS > 0
+        #if UART_TX_BUFFER_SIZE == 0 || UART_RX_BUFFER_SIZE == 0
+            #error "UART_RTOS requires UART_TX_BUFFER_SIZE > 0 and UART_RX_BUFFER_SIZE > 0"
+        #endif
+    #endif
+    /* @} */
+
+    /**
+     * @defgroup UART_Handover_Mode UART Bootloader Handover Macros
+     * @brief Configuration macros for adopting the link configuration of a bootloader.
+     *
+     * @details
+     * With UART_HANDOVER enabled, uart_init() keeps the baud rate (UBRR, U2X) and writes the frame format (UCSRC) a bootloader has left in the handover record of uart_handover.h instead of the compile-time values, the application continues on the already negotiated link without a renegotiation. Without a valid record uart_init() uses the compile-time configuration as usual.
+     *
+     * @note uart_clock() reprograms UBRR/U2X from its compile-time table, i.e. for UART_BAUDRATE.
+     */
+    /* @{ */
+    #ifndef UART_HANDOVER
+        /**
+         * @def UART_HANDOVER
+         * @brief Bootloader handover (0 = disabled, default; 1 = enabled).
+         */
+        #define UART_HANDOVER 0
+    #endif
+
+    #if UART_HANDOVER > 0
+        #if UART_MODE == 1 || UART_DITHER > 0
+            #error "UART_HANDOVER cannot be combined with UART_MODE 1 (MSPIM) or UART_DITHER"
+        #endif
+    #endif
+    /* @} */
+
+	#include <stdio.h>
+	#include <stdint.h>
+	#include <avr/io.h>
+	#include <util/setbaud.h>
+
+	#include "../common/enums/UART_enums.h"
+
+	#if UART_HANDOVER > 0
+		#include "uart_handover.h"
+	#endif
+
+	#ifdef __cplusplus
+		extern "C" {
+	#endif
+
+	#if UART_MODE == 1
+		// The ATmega8/16/32 USART has a single UMSEL bit (synchronous slave/master), no SPI master mode
+		#if !defined(UMSEL1) || !defined(UMSEL0)
+			#error "UART_MODE 1 (MSPIM) requires a USART with unsuffixed UMSEL1/UMSEL0 (supported: ATtiny2313A, ATtiny4313), not available on this device"
+		#endif
+
+		#if UART_TX_BUFFER_SIZE > 0 || UART_RX_BUFFER_SIZE > 0 || UART_CALIBRATION > 0 || UART_CLOCK > 0 || UART_DITHER > 0 || UART_TX_PACING > 0
+			#error "UART_MODE 1 (MSPIM) cannot be combined with buffered modes, calibration, clock switching or dithering"
+		#endif
+
+		// In MSPIM the character size bits select the SPI format
+		#ifndef UDORD
+			#define UDORD UCSZ1
+		#endif
+
+		#ifndef UCPHA
+			#define UCPHA UCSZ0
+		#endif
+	#endif
+
+	void uart_init(void);
+	void uart_disable(void);
+
+	#if UART_CALIBRATION > 0
+		char uart_calibrate(void);
+	#endif
+
+	#if UART_CLOCK > 0
+		char uart_clock(unsigned char prescaler);
+	#endif
+
+	#if UART_TX_PACING > 0 || UART_RX_COALESCE > 0 || UART_FRAME_COALESCE > 0 || UART_FRAME_RX_TIMEOUT > 0
+		#define UART_TICK_USED
+	#endif
+
+	#ifdef UART_TICK_USED
+		void uart_tick(void);
+	#endif
+
+	#if UART_RTOS > 0
+		void uart_lock(void);
+		void uart_unlock(void);
+	#endif
+
+	#if UART_MODE == 1
+		uint8_t uart_spi_exchange(uint8_t data);
+		void uart_spi_transfer(const uint8_t *transmit, uint8_t *receive, uint16_t length);
+	#endif
+
+	#if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+		char uart_putchar(char data);
+		char uart_write(const char *data, unsigned char length);
+		void uart_flush(void);
+		unsigned char uart_tx_active(void);
+
+		#if UART_TX_BUFFER_SIZE > 0
+			char uart_write_policy(const char *data, unsigned char length, unsigned char policy);
+			unsigned char uart_tx_overflow(unsigned char policy);
+			uint16_t uart_tx_discarded(void);
+		#endif
+
+		#if UART_STREAM > 0
+			void uart_stream_start(void (*producer)(void));
+			unsigned char *uart_stream_buffer(void);
+			void uart_stream_submit(unsigned char length);
+			void uart_stream_stop(void);
+			uint16_t uart_stream_underruns(void);
+		#endif
+
+		#if UART_FRAME > 0
+			char uart_frame_write(const void *data, uint16_t length);
+			char uart_frame_flush(void);
+			char uart_frame_begin(uint16_t length);
+			void uart_frame_put(const void *data, uint16_t length);
+			char uart_frame_end(void);
+		#endif
+	
+		#if UART_STDMODE == 1 || UART_STDMODE == 2
+			int uart_printf(char data, FILE *stream);
+		#endif
+	#endif
+
+	#if !defined(UART_RXCIE)
+			 char uart_getchar(UART_Data *status);
+		UART_Data uart_scanchar(char *data);
+		UART_Error uart_error_flags(void);
+
+		#if UART_RX_BUFFER_SIZE > 0
+			void uart_rx_overflow(unsigned char policy);
+			uint16_t uart_rx_discarded(void);
+		#endif
+
+		#if UART_RX_COALESCE > 0
+			void uart_rx_notify(void (*callback)(void));
+			unsigned char uart_rx_ready(void);
+		#endif
+
+		#if UART_FRAME_RX > 0
+			UART_Data uart_frame_read(void *data, uint16_t size, uint16_t *length);
+			unsigned char uart_frame_available(void);
+			void uart_frame_notify(void (*callback)(void));
+			uint16_t uart_frame_rejected(void);
+		#endif
+
+		#if UART_EVENT > 0
+			/**
+			 * @brief Coalesced event of the event queue.
+			 */
+			typedef struct
+			{
+				unsigned char type;     /**< UART_EVENT_FRAME, UART_EVENT_OVERRUN, ... */
+				uint16_t count;         /**< Occurrences since the event has been queued (saturates at 65535) */
+			} UART_Event;
+
+			unsigned char uart_event_read(UART_Event *event);
+			void uart_event_notify(void (*callback)(void));
+			uint16_t uart_event_lost(void);
+		#endif
+        
+		#if UART_STDMODE == 1 || UART_STDMODE == 3
+				 int uart_scanf(FILE *stream);
+				void uart_clear(void);
+		#endif
+	#endif
+
+	#if !defined(UART_TXCIE) && !defined(UART_UDRIE) && !defined(UART_RXCIE)
+		#if UART_HANDSHAKE > 0
+			UART_Handshake uart_handshake(UART_Handshake status);
+		#endif
+	#endif
+
+	#ifdef __cplusplus
+		}
 	#endif
 
 #endif /* UART_H_ */
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+ * @file uart_handover.h
+ * @brief Header file with the handover record between bootloader and application.
+ *
+ * This file provides the record in which a bootloader leaves its negotiated baud rate and frame format to the application. The record lives in uninitialized memory (.noinit), so it survives the jump from the bootloader into the application but is not trusted without its magic value.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_HANDOVER_H_
+#define UART_HANDOVER_H_
+
+    /**
+     * @defgroup UART_Handover UART Handover Record
+     * @brief Layout and placement of the handover record.
+     *
+     * @details
+     * The bootloader fills the record (uart_tiny_handover() with UART_TINY_HANDOVER > 0) right before it jumps into the application without a reset, the USART keeps running with the negotiated settings. uart_init() of the application (UART_HANDOVER > 0) accepts the record only if the magic value is set and UBRR and U2X still hold the recorded values, then keeps them and writes the recorded frame format instead of the compile-time one. The record is invalidated when it is read, a later reset that does not pass through the bootloader handover falls back to the compile-time configuration.
+     *
+     * Bootloader and application are separate images, the record has to be placed at the same address in both. With the default ".noinit" this only holds if both images place .noinit identically, otherwise move it into a dedicated section at the start of SRAM and shift .data behind it in both images, e.g. UART_HANDOVER_SECTION ".handover" with "-Wl,--section-start=.handover=0x800060 -Wl,-Tdata=0x800066" (ATmega16/32).
+     *
+     * @note UCSRC is kept in the record because on ATmega8/16/32 it shares its address with UBRRH and can only be read back with two consecutive reads.
+     */
+    /* @{ */
+
+    #ifndef UART_HANDOVER_SECTION
+        /**
+         * @def UART_HANDOVER_SECTION
+         * @brief Linker section of the handover record (default ".noinit").
+         */
+        #define UART_HANDOVER_SECTION ".noinit"
+    #endif
+
+    /**
+     * @def UART_HANDOVER_MAGIC
+     * @brief Marks a valid handover record.
+     */
+    #define UART_HANDOVER_MAGIC 0xB007
+
+    #include <stdint.h>
+
+    /**
+     * @brief Handover record, written by the bootloader and consumed by uart_init().
+     */
+    typedef struct
+    {
+        uint16_t magic;             /**< UART_HANDOVER_MAGIC if valid */
+        uint16_t ubrr;              /**< UBRRH/UBRRL of the negotiated baud rate */
+        uint8_t ucsra;              /**< U2X bit of UCSRA */
+        uint8_t ucsrc;              /**< Frame format bits of UCSRC (UPM, USBS, UCSZ1:0, without URSEL) */
+    } UART_Handover;
+    /* @} */
+
+#endif /* UART_HANDOVER_H_ */
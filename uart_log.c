@@ -0,0 +1,294 @@
+/**
+ * @file uart_log.c
+ * @brief Source file with implementation of the leveled logging facility.
+ *
+ * This file contains the runtime level table and the line formatter. A line is formatted completely before it is handed to the transmit path as one message.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_log.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_log.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <util/atomic.h>
+
+#if UART_LOG_REPEAT_HISTORY > 0
+    #include <util/crc16.h>
+#endif
+
+static uint8_t uart_log_levels[UART_LOG_MODULES] = { [0 ... UART_LOG_MODULES - 1] = UART_LOG_LEVEL };
+
+static const char uart_log_letters[] PROGMEM = "EWID";
+
+#if UART_LOG_REPEAT_HISTORY > 0
+    /**
+     * @brief Remembered line of the repeat suppression.
+     */
+    struct uart_log_repeat
+    {
+        uint16_t hash;
+        uint16_t count;                                     // Suppressed repetitions
+        uint8_t length;                                     // Length of the line, 0 = unused entry
+        char text[UART_LOG_REPEAT_TEXT];                    // Start of the line for the summary
+    };
+
+    static struct uart_log_repeat uart_log_repeats[UART_LOG_REPEAT_HISTORY];
+    static uint8_t uart_log_oldest;                         // Entry replaced by the next new line
+#endif
+
+#if UART_LOG_RATE_LIMIT > 0
+    static uint8_t uart_log_lines[UART_LOG_MODULES];        // Lines sent in the current period
+    static uint16_t uart_log_dropped[UART_LOG_MODULES];     // Lines dropped in the current period
+#endif
+
+/**
+ * @brief Transmit a complete line with the log overflow policy.
+ *
+ * @param line Line including newline.
+ * @param length Length of the line.
+ */
+static void uart_log_line(const char *line, unsigned char length)
+{
+    #if UART_TX_BUFFER_SIZE > 0
+        // The global policy stays untouched for ISRs and other tasks writing meanwhile
+        uart_write_policy(line, length, UART_LOG_OVERFLOW);
+    #else
+        uart_write(line, length);
+    #endif
+}
+
+#if UART_LOG_REPEAT_HISTORY > 0
+    /**
+     * @brief Report the suppressed repetitions of a remembered line.
+     *
+     * @param repeat Copy of the entry.
+     */
+    static void uart_log_summary(const struct uart_log_repeat *repeat)
+    {
+        char line[UART_LOG_REPEAT_TEXT + 32];
+        uint8_t length = (repeat->length < UART_LOG_REPEAT_TEXT) ? repeat->length : UART_LOG_REPEAT_TEXT;
+
+        memcpy(line, repeat->text, length);
+        length += snprintf_P(&line[length], sizeof(line) - length, (repeat->length > UART_LOG_REPEAT_TEXT) ? PSTR("... repeated %u times\n") : PSTR(" repeated %u times\n"), repeat->count);
+
+        uart_log_line(line, length);
+    }
+
+    /**
+     * @brief Check a line against the remembered lines.
+     *
+     * @param length Length of the line.
+     * @param hash Hash of the line.
+     * @return 1 if the line is a repetition and has been counted, 0 if it is new.
+     */
+    static uint8_t uart_log_repeated(uint8_t length, uint16_t hash)
+    {
+        // Lines may be logged from ISRs
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            for (uint8_t i = 0; i < UART_LOG_REPEAT_HISTORY; i++)
+            {
+                struct uart_log_repeat *repeat = &uart_log_repeats[i];
+
+                if (repeat->length == length && repeat->hash == hash)
+                {
+                    if (repeat->count < 0xFFFF)
+                    {
+                        repeat->count++;
+                    }
+                    return 1;
+                }
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Remember a sent line.
+     *
+     * @param line Formatted line without newline.
+     * @param length Length of the line.
+     * @param hash Hash of the line.
+     *
+     * @details
+     * The line replaces the oldest entry, whose repetitions are reported first.
+     */
+    static void uart_log_remember(const char *line, uint8_t length, uint16_t hash)
+    {
+        struct uart_log_repeat forgotten;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            struct uart_log_repeat *oldest = &uart_log_repeats[uart_log_oldest];
+
+            forgotten = *oldest;
+            oldest->hash = hash;
+            oldest->count = 0;
+            oldest->length = length;
+            memcpy(oldest->text, line, (length < UART_LOG_REPEAT_TEXT) ? length : UART_LOG_REPEAT_TEXT);
+
+            if (++uart_log_oldest >= UART_LOG_REPEAT_HISTORY)
+            {
+                uart_log_oldest = 0;
+            }
+        }
+
+        if (forgotten.count)
+        {
+            uart_log_summary(&forgotten);
+        }
+    }
+#endif
+
+/**
+ * @brief Set the runtime level of a module.
+ *
+ * @param module Module number.
+ * @param level UART_LOG_NONE - UART_LOG_DEBUG, levels above UART_LOG_LEVEL have no effect.
+ */
+void uart_log_level(uint8_t module, uint8_t level)
+{
+    if (module < UART_LOG_MODULES)
+    {
+        uart_log_levels[module] = level;
+    }
+}
+
+/**
+ * @brief Check if a module logs a level.
+ *
+ * @param level Level of the statement.
+ * @param module Module number.
+ * @return 1 if enabled, otherwise 0.
+ */
+uint8_t uart_log_enabled(uint8_t level, uint8_t module)
+{
+    return module < UART_LOG_MODULES && level && level <= uart_log_levels[module];
+}
+
+/**
+ * @brief Format and transmit a log line.
+ *
+ * @param level Level of the line.
+ * @param module Module number.
+ * @param format printf() format string in flash memory.
+ *
+ * @details
+ * Called by the UART_LOG macros, which already checked the level. The line is truncated to UART_LOG_LINE_SIZE, the newline is always kept.
+ */
+void uart_log_write(uint8_t level, uint8_t module, PGM_P format, ...)
+{
+    char line[UART_LOG_LINE_SIZE];
+    va_list arguments;
+    int length;
+
+    length = snprintf_P(line, sizeof(line) - 1, PSTR("%c%u: "), pgm_read_byte(&uart_log_letters[level - 1]), module);
+
+    va_start(arguments, format);
+    length += vsnprintf_P(&line[length], sizeof(line) - 1 - length, format, arguments);
+    va_end(arguments);
+
+    // snprintf() returns the untruncated length
+    if (length > (int)sizeof(line) - 2)
+    {
+        length = sizeof(line) - 2;
+    }
+
+    #if UART_LOG_REPEAT_HISTORY > 0
+        uint16_t hash = 0;
+
+        for (uint8_t i = 0; i < length; i++)
+        {
+            hash = _crc_xmodem_update(hash, line[i]);
+        }
+
+        // Repetitions do not count against the rate limit
+        if (uart_log_repeated((uint8_t)length, hash))
+        {
+            return;
+        }
+    #endif
+
+    #if UART_LOG_RATE_LIMIT > 0
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (uart_log_lines[module] >= UART_LOG_RATE_LIMIT)
+            {
+                if (uart_log_dropped[module] < 0xFFFF)
+                {
+                    uart_log_dropped[module]++;
+                }
+                return;
+            }
+            uart_log_lines[module]++;
+        }
+    #endif
+
+    #if UART_LOG_REPEAT_HISTORY > 0
+        uart_log_remember(line, (uint8_t)length, hash);
+    #endif
+
+    line[length++] = '\n';
+    uart_log_line(line, (unsigned char)length);
+}
+
+/**
+ * @brief End the current suppression window.
+ *
+ * @details
+ * Called periodically from the main loop, not from an ISR. Reports the repetitions of all remembered lines and forgets them, reports the lines dropped by the rate limit and starts a new rate limit period. Without repeat suppression and rate limit it does nothing.
+ */
+void uart_log_tick(void)
+{
+    #if UART_LOG_REPEAT_HISTORY > 0
+        for (uint8_t i = 0; i < UART_LOG_REPEAT_HISTORY; i++)
+        {
+            struct uart_log_repeat repeat;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                repeat = uart_log_repeats[i];
+                uart_log_repeats[i].length = 0;
+                uart_log_repeats[i].count = 0;
+            }
+
+            if (repeat.length && repeat.count)
+            {
+                uart_log_summary(&repeat);
+            }
+        }
+    #endif
+
+    #if UART_LOG_RATE_LIMIT > 0
+        for (uint8_t module = 0; module < UART_LOG_MODULES; module++)
+        {
+            uint16_t dropped;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                dropped = uart_log_dropped[module];
+                uart_log_dropped[module] = 0;
+                uart_log_lines[module] = 0;
+            }
+
+            if (dropped)
+            {
+                char line[32];
+
+                uart_log_line(line, (unsigned char)snprintf_P(line, sizeof(line), PSTR("W%u: %u lines dropped\n"), module, dropped));
+            }
+        }
+    #endif
+}
@@ -0,0 +1,199 @@
+/**
+ * @file uart_log.h
+ * @brief Header file with declarations of the leveled logging facility.
+ *
+ * This file provides log macros with a compile-time minimum level and a runtime level per module. Calls below UART_LOG_LEVEL expand to nothing, so neither their arguments are evaluated nor their format strings are placed in flash memory. A production build keeps its debug log statements in the source at no cost.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_LOG_H_
+#define UART_LOG_H_
+
+    /**
+     * @defgroup UART_Log UART Log Macros
+     * @brief Configuration macros, levels and log statements.
+     *
+     * @details
+     * Every line is formatted into a buffer on the stack and written with one uart_write(), so lines from different contexts never interleave. With UART_TX_BUFFER_SIZE > 0 lines are queued with the overflow policy UART_LOG_OVERFLOW, a full transmit queue drops log lines instead of stalling the caller.
+     *
+     * Line format: level letter (E, W, I, D), module number, message, e.g. "W3: low battery\n".
+     *
+     * Two stages protect the link during failure storms, uart_log_tick() is called periodically from the main loop (e.g. once per second) to end their windows:
+     * - Repeat suppression: the last UART_LOG_REPEAT_HISTORY distinct lines are remembered by hash. A line that is already remembered is not sent again but counted, its count is reported as "<line>... repeated N times" when the line is forgotten or with the next uart_log_tick().
+     * - Rate limit: each module sends at most UART_LOG_RATE_LIMIT lines per uart_log_tick() period, the rest is counted and reported as "W<module>: N lines dropped".
+     *
+     * @code
+     * #define LOG_MOTOR 2
+     *
+     * UART_LOG_W(LOG_MOTOR, "stall at %u rpm", rpm);
+     * UART_LOG_D(LOG_MOTOR, "pwm=%u", pwm_duty());     // Not even pwm_duty() remains with UART_LOG_LEVEL < UART_LOG_DEBUG
+     * @endcode
+     */
+    /* @{ */
+
+    /**
+     * @def UART_LOG_NONE
+     * @brief Level: logging disabled.
+     */
+    #define UART_LOG_NONE 0
+
+    /**
+     * @def UART_LOG_ERROR
+     * @brief Level: errors.
+     */
+    #define UART_LOG_ERROR 1
+
+    /**
+     * @def UART_LOG_WARNING
+     * @brief Level: warnings.
+     */
+    #define UART_LOG_WARNING 2
+
+    /**
+     * @def UART_LOG_INFO
+     * @brief Level: information.
+     */
+    #define UART_LOG_INFO 3
+
+    /**
+     * @def UART_LOG_DEBUG
+     * @brief Level: debug output.
+     */
+    #define UART_LOG_DEBUG 4
+
+    #ifndef UART_LOG_LEVEL
+        /**
+         * @def UART_LOG_LEVEL
+         * @brief Compile-time minimum level, statements above it are removed (default UART_LOG_INFO).
+         *
+         * @details
+         * Also the initial runtime level of all modules.
+         */
+        #define UART_LOG_LEVEL UART_LOG_INFO
+    #endif
+
+    #ifndef UART_LOG_MODULES
+        /**
+         * @def UART_LOG_MODULES
+         * @brief Number of modules with a runtime level (default 8, module numbers 0 - UART_LOG_MODULES-1).
+         */
+        #define UART_LOG_MODULES 8
+    #endif
+
+    #ifndef UART_LOG_LINE_SIZE
+        /**
+         * @def UART_LOG_LINE_SIZE
+         * @brief Maximum length of a log line including prefix and newline (default 64), longer messages are truncated.
+         *
+         * @note The line buffer is allocated on the stack of the caller.
+         */
+        #define UART_LOG_LINE_SIZE 64
+    #endif
+
+    #ifndef UART_LOG_OVERFLOW
+        /**
+         * @def UART_LOG_OVERFLOW
+         * @brief Overflow policy of log lines (default UART_OVERFLOW_DROP_MESSAGE).
+         */
+        #define UART_LOG_OVERFLOW UART_OVERFLOW_DROP_MESSAGE
+    #endif
+
+    #ifndef UART_LOG_REPEAT_HISTORY
+        /**
+         * @def UART_LOG_REPEAT_HISTORY
+         * @brief Number of remembered lines for repeat suppression (0 = disabled, default 4).
+         */
+        #define UART_LOG_REPEAT_HISTORY 4
+    #endif
+
+    #ifndef UART_LOG_REPEAT_TEXT
+        /**
+         * @def UART_LOG_REPEAT_TEXT
+         * @brief Number of characters of a remembered line that are repeated in its summary (default 16).
+         */
+        #define UART_LOG_REPEAT_TEXT 16
+    #endif
+
+    #ifndef UART_LOG_RATE_LIMIT
+        /**
+         * @def UART_LOG_RATE_LIMIT
+         * @brief Maximum lines per module and uart_log_tick() period (0 = unlimited, default).
+         */
+        #define UART_LOG_RATE_LIMIT 0
+    #endif
+
+    #if UART_LOG_LEVEL < UART_LOG_NONE || UART_LOG_LEVEL > UART_LOG_DEBUG
+        #error "UART_LOG_LEVEL has to be UART_LOG_NONE - UART_LOG_DEBUG"
+    #endif
+
+    #if UART_LOG_MODULES < 1 || UART_LOG_MODULES > 255
+        #error "UART_LOG_MODULES has to be 1-255"
+    #endif
+
+    #if UART_LOG_LINE_SIZE < 8 || UART_LOG_LINE_SIZE > 255
+        #error "UART_LOG_LINE_SIZE has to be 8-255"
+    #endif
+
+    #if UART_LOG_REPEAT_HISTORY > 255 || UART_LOG_REPEAT_TEXT < 1 || UART_LOG_REPEAT_TEXT >= UART_LOG_LINE_SIZE || UART_LOG_RATE_LIMIT > 255
+        #error "UART_LOG_REPEAT_HISTORY/UART_LOG_REPEAT_TEXT/UART_LOG_RATE_LIMIT out of range"
+    #endif
+
+    /**
+     * @def UART_LOG
+     * @brief Log statement of a level, only evaluated if the module level enables it.
+     *
+     * @details
+     * The format string is placed in flash memory. Prefer UART_LOG_E(), UART_LOG_W(), UART_LOG_I() and UART_LOG_D(), which are removed at compile time.
+     */
+    #define UART_LOG(level, module, format, ...) do { if (uart_log_enabled((level), (module))) { uart_log_write((level), (module), PSTR(format), ##__VA_ARGS__); } } while (0)
+
+    #if UART_LOG_LEVEL >= UART_LOG_ERROR
+        #define UART_LOG_E(module, format, ...) UART_LOG(UART_LOG_ERROR, module, format, ##__VA_ARGS__)
+    #else
+        #define UART_LOG_E(module, format, ...) do { } while (0)
+    #endif
+
+    #if UART_LOG_LEVEL >= UART_LOG_WARNING
+        #define UART_LOG_W(module, format, ...) UART_LOG(UART_LOG_WARNING, module, format, ##__VA_ARGS__)
+    #else
+        #define UART_LOG_W(module, format, ...) do { } while (0)
+    #endif
+
+    #if UART_LOG_LEVEL >= UART_LOG_INFO
+        #define UART_LOG_I(module, format, ...) UART_LOG(UART_LOG_INFO, module, format, ##__VA_ARGS__)
+    #else
+        #define UART_LOG_I(module, format, ...) do { } while (0)
+    #endif
+
+    #if UART_LOG_LEVEL >= UART_LOG_DEBUG
+        #define UART_LOG_D(module, format, ...) UART_LOG(UART_LOG_DEBUG, module, format, ##__VA_ARGS__)
+    #else
+        #define UART_LOG_D(module, format, ...) do { } while (0)
+    #endif
+    /* @} */
+
+    #include <stdint.h>
+    #include <avr/pgmspace.h>
+
+    #include "uart.h"
+
+    #if defined(UART_TXCIE) || defined(UART_UDRIE)
+        #error "uart_log requires the transmit functions (UART_TXCIE/UART_UDRIE not defined)"
+    #endif
+
+    void uart_log_level(uint8_t module, uint8_t level);
+    uint8_t uart_log_enabled(uint8_t level, uint8_t module);
+    void uart_log_write(uint8_t level, uint8_t module, PGM_P format, ...);
+    void uart_log_tick(void);
+
+#endif /* UART_LOG_H_ */
@@ -0,0 +1,190 @@
+/**
+ * @file uart_memory.c
+ * @brief Source file with implementation of the remote memory access methods.
+ *
+ * This file contains the whitelist check and the block transfers. Read data is streamed from its memory space directly into the response frame, so a block is not limited by the result buffer of the RPC layer.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_memory.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_memory.h"
+
+#include <string.h>
+#include <avr/eeprom.h>
+#include <util/atomic.h>
+
+static const UART_Memory_Region *uart_memory_regions;       // Whitelist in flash memory
+static uint8_t uart_memory_count;
+
+/**
+ * @brief Register the whitelist.
+ *
+ * @param regions Regions in flash memory (PROGMEM) that the host may access.
+ * @param count Number of regions.
+ *
+ * @code
+ * static uint16_t calibration[64];
+ *
+ * static const UART_Memory_Region memory_regions[] PROGMEM = {
+ *     { UART_MEMORY_RAM, UART_MEMORY_READ | UART_MEMORY_WRITE, (uint16_t)calibration, sizeof(calibration) },
+ *     { UART_MEMORY_EEPROM, UART_MEMORY_READ | UART_MEMORY_WRITE, 0, 256 }
+ * };
+ *
+ * uart_memory_init(memory_regions, sizeof(memory_regions) / sizeof(memory_regions[0]));
+ * @endcode
+ */
+void uart_memory_init(const UART_Memory_Region *regions, uint8_t count)
+{
+    uart_memory_regions = regions;
+    uart_memory_count = count;
+}
+
+/**
+ * @brief Check a block against the whitelist.
+ *
+ * @param space Memory space.
+ * @param address First address of the block.
+ * @param length Size of the block in bytes.
+ * @param access Required access right.
+ * @return 1 if the block lies inside one region with the access right, otherwise 0.
+ */
+static uint8_t uart_memory_allowed(uint8_t space, uint16_t address, uint16_t length, uint8_t access)
+{
+    for (uint8_t i = 0; i < uart_memory_count; i++)
+    {
+        UART_Memory_Region region;
+
+        memcpy_P(&region, &uart_memory_regions[i], sizeof(region));
+
+        // Written as differences, a region may end at the top of the address space
+        if (region.space == space && (region.access & access) && address >= region.start && (uint16_t)(address - region.start) <= region.length && length <= region.length - (uint16_t)(address - region.start))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief RPC method: read a memory block.
+ *
+ * @param id Request ID.
+ * @param args Space (1 byte), address (2 bytes) and length (1 byte).
+ * @param length Number of argument bytes.
+ * @param[out] result Unused, the data is streamed into the response frame.
+ * @param[in,out] size Result length.
+ * @return UART_RPC_DEFERRED after the response has been sent, UART_RPC_ERROR on malformed arguments or a block that does not fit the frame, UART_MEMORY_DENIED.
+ *
+ * @details
+ * Blocks up to 255 bytes are independent of UART_RPC_RESULT_MAX. With a 1 byte frame length prefix the response has to fit into 255 bytes, so reads are limited to 252 bytes there.
+ */
+uint8_t uart_memory_read(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size)
+{
+    if (length != 4)
+    {
+        return UART_RPC_ERROR;
+    }
+
+    uint8_t space = args[0];
+    uint16_t address = args[1] | ((uint16_t)args[2] << 8);
+    uint8_t count = args[3];
+
+    #if UART_FRAME_LENGTH_BYTES == 1
+        if (count > (255 - UART_RPC_HEADER))
+        {
+            return UART_RPC_ERROR;
+        }
+    #endif
+
+    if (!uart_memory_allowed(space, address, count, UART_MEMORY_READ))
+    {
+        return UART_MEMORY_DENIED;
+    }
+
+    uint8_t header[UART_RPC_HEADER] = { id, UART_RPC_OK, count };
+    uint8_t chunk[UART_MEMORY_CHUNK];
+
+    uart_frame_begin(UART_RPC_HEADER + count);
+    uart_frame_put(header, UART_RPC_HEADER);
+
+    while (count)
+    {
+        uint8_t part = (count < UART_MEMORY_CHUNK) ? count : UART_MEMORY_CHUNK;
+
+        if (space == UART_MEMORY_RAM)
+        {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                memcpy(chunk, (const void *)address, part);
+            }
+        }
+        else if (space == UART_MEMORY_EEPROM)
+        {
+            eeprom_read_block(chunk, (const void *)address, part);
+        }
+        else
+        {
+            memcpy_P(chunk, (PGM_VOID_P)address, part);
+        }
+
+        uart_frame_put(chunk, part);
+        address += part;
+        count -= part;
+    }
+
+    uart_frame_end();
+    return UART_RPC_DEFERRED;
+}
+
+/**
+ * @brief RPC method: write a memory block.
+ *
+ * @param id Request ID.
+ * @param args Space (1 byte), address (2 bytes) and data.
+ * @param length Number of argument bytes.
+ * @param[out] result Unused.
+ * @param[in,out] size Result length.
+ * @return UART_RPC_OK, UART_RPC_ERROR on malformed arguments or UART_MEMORY_DENIED.
+ *
+ * @details
+ * The data size is limited by UART_FRAME_RX_MAX. RAM blocks are written with interrupts disabled. EEPROM blocks are written with eeprom_update_block(), which only programs changed bytes but blocks for about 3.4 ms per changed byte.
+ */
+uint8_t uart_memory_write(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size)
+{
+    if (length < 3)
+    {
+        return UART_RPC_ERROR;
+    }
+
+    uint8_t space = args[0];
+    uint16_t address = args[1] | ((uint16_t)args[2] << 8);
+    uint8_t count = length - 3;
+
+    if (space == UART_MEMORY_FLASH || !uart_memory_allowed(space, address, count, UART_MEMORY_WRITE))
+    {
+        return UART_MEMORY_DENIED;
+    }
+
+    if (space == UART_MEMORY_RAM)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            memcpy((void *)address, &args[3], count);
+        }
+    }
+    else
+    {
+        eeprom_update_block(&args[3], (void *)address, count);
+    }
+    return UART_RPC_OK;
+}
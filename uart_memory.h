@@ -0,0 +1,103 @@
+/**
+ * @file uart_memory.h
+ * @brief Header file with declarations of the remote memory access methods.
+ *
+ * This file provides block read and write of RAM, EEPROM and flash memory as RPC methods. Every access is checked against a whitelist of regions in flash memory. A calibration tool pipelines the blocks of a whole table as one batch of requests, so kilobytes are transferred in a single round trip instead of one text command per parameter.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_MEMORY_H_
+#define UART_MEMORY_H_
+
+    /**
+     * @defgroup UART_Memory UART Memory Access Macros
+     * @brief Memory spaces, access rights and status codes of the memory access methods.
+     *
+     * @details
+     * Both methods are entries for the method table of uart_rpc_init() (see @ref UART_RPC):
+     *
+     * uart_memory_read():  space (1 byte), address (2 bytes), length (1 byte) -> data.
+     * uart_memory_write(): space (1 byte), address (2 bytes), data -> nothing.
+     *
+     * Addresses are little-endian. Flash memory is read only, a region with UART_MEMORY_WRITE in flash memory is not writable.
+     */
+    /* @{ */
+    #ifndef UART_MEMORY_CHUNK
+        /**
+         * @def UART_MEMORY_CHUNK
+         * @brief Size of the copy buffer of uart_memory_read() in bytes (default 16).
+         *
+         * @details
+         * Read data is streamed into the response frame in chunks of this size. RAM chunks are copied with interrupts disabled, so variables written by ISRs are read consistently within a chunk.
+         */
+        #define UART_MEMORY_CHUNK 16
+    #endif
+
+    /**
+     * @def UART_MEMORY_RAM
+     * @brief Memory space: SRAM (data address space, includes I/O registers).
+     */
+    #define UART_MEMORY_RAM 0
+
+    /**
+     * @def UART_MEMORY_EEPROM
+     * @brief Memory space: EEPROM.
+     */
+    #define UART_MEMORY_EEPROM 1
+
+    /**
+     * @def UART_MEMORY_FLASH
+     * @brief Memory space: flash memory (read only, first 64 KiB).
+     */
+    #define UART_MEMORY_FLASH 2
+
+    /**
+     * @def UART_MEMORY_READ
+     * @brief Access right: region may be read.
+     */
+    #define UART_MEMORY_READ 0x01
+
+    /**
+     * @def UART_MEMORY_WRITE
+     * @brief Access right: region may be written.
+     */
+    #define UART_MEMORY_WRITE 0x02
+
+    /**
+     * @def UART_MEMORY_DENIED
+     * @brief Status: the block is not inside a region with the requested access right.
+     */
+    #define UART_MEMORY_DENIED 4
+    /* @} */
+
+    #include <stdint.h>
+    #include <avr/pgmspace.h>
+
+    #include "uart_rpc.h"
+
+    /**
+     * @brief Whitelisted memory region.
+     */
+    typedef struct
+    {
+        uint8_t space;          /**< UART_MEMORY_RAM, UART_MEMORY_EEPROM or UART_MEMORY_FLASH */
+        uint8_t access;         /**< UART_MEMORY_READ and/or UART_MEMORY_WRITE */
+        uint16_t start;         /**< First address of the region */
+        uint16_t length;        /**< Size of the region in bytes */
+    } UART_Memory_Region;
+
+    void uart_memory_init(const UART_Memory_Region *regions, uint8_t count);
+    uint8_t uart_memory_read(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size);
+    uint8_t uart_memory_write(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size);
+
+#endif /* UART_MEMORY_H_ */
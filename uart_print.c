@@ -0,0 +1,390 @@
+/**
+ * @file uart_print.c
+ * @brief Source file with implementation of formatted UART output without stdio.
+ *
+ * This file contains typed emitters that convert their arguments directly onto the UART transmit path. Decimal conversion uses a power-of-ten subtraction table in flash instead of 32-bit divisions, which are expensive on AVR cores without a hardware divider.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_print.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_print.h"
+
+#if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+
+    static const uint32_t uart_print_decades[] PROGMEM = {
+        1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL
+    };
+
+    /**
+     * @brief Convert an unsigned integer into decimal digits.
+     *
+     * @param value Value to convert.
+     * @param[out] buffer Buffer for at least 10 digits (not zero terminated).
+     * @return Number of digits written to buffer.
+     */
+    static unsigned char uart_print_digits(uint32_t value, char *buffer)
+    {
+        unsigned char length = 0;
+
+        for (unsigned char i = 0; i < (sizeof(uart_print_decades)/sizeof(uart_print_decades[0])); i++)
+        {
+            uint32_t decade = pgm_read_dword(&uart_print_decades[i]);
+            char digit = '0';
+
+            while (value >= decade)
+            {
+                value -= decade;
+                digit++;
+            }
+
+            // Suppress leading zeros
+            if (digit != '0' || length)
+            {
+                buffer[length++] = digit;
+            }
+        }
+        buffer[length++] = (char)('0' + value);
+
+        return length;
+    }
+
+    /**
+     * @brief Convert and transmit a decimal number with optional sign and padding.
+     *
+     * @param value Magnitude to transmit.
+     * @param width Minimum field width including the sign (0 = no padding).
+     * @param fill Padding character (' ' or '0').
+     * @param sign Sign character to prefix or 0 for none.
+     *
+     * @details
+     * Zero padding is placed between sign and digits, space padding in front of the sign (same as printf "%05d" and "%5d").
+     */
+    static void uart_print_number(uint32_t value, uint8_t width, char fill, char sign)
+    {
+        char buffer[10];
+        unsigned char length = uart_print_digits(value, buffer);
+        unsigned char total = length;
+
+        if (sign)
+        {
+            total++;
+
+            if (fill == '0')
+            {
+                uart_putchar(sign);
+                sign = 0;
+            }
+        }
+
+        while (width > total)
+        {
+            uart_putchar(fill);
+            width--;
+        }
+
+        if (sign)
+        {
+            uart_putchar(sign);
+        }
+
+        for (unsigned char i = 0; i < length; i++)
+        {
+            uart_putchar(buffer[i]);
+        }
+    }
+
+    /**
+     * @brief Transmit a binary fixed-point number split into integer and fraction part.
+     *
+     * @param integer Integer part of the magnitude.
+     * @param fraction Fraction part of the magnitude with fraction_bits significant bits.
+     * @param fraction_bits Number of fraction bits (0-28).
+     * @param decimals Number of decimal places to transmit (0-9).
+     * @param sign Sign character to prefix or 0 for none.
+     *
+     * @details
+     * Each decimal place is extracted by multiplying the fraction with 10 and shifting out the integer part. The last place is rounded half up, a carry is propagated into the integer part.
+     */
+    static void uart_print_fraction(uint32_t integer, uint32_t fraction, uint8_t fraction_bits, uint8_t decimals, char sign)
+    {
+        char buffer[9];
+        uint32_t mask = (1UL<<fraction_bits) - 1UL;
+
+        if (decimals > sizeof(buffer))
+        {
+            decimals = sizeof(buffer);
+        }
+
+        for (unsigned char i = 0; i < decimals; i++)
+        {
+            fraction *= 10;
+            buffer[i] = (char)('0' + (fraction >> fraction_bits));
+            fraction &= mask;
+        }
+
+        // Round half up and propagate carry
+        if (fraction_bits && (fraction >> (fraction_bits - 1)))
+        {
+            unsigned char i = decimals;
+
+            while (i && buffer[i - 1] == '9')
+            {
+                buffer[--i] = '0';
+            }
+
+            if (i)
+            {
+                buffer[i - 1]++;
+            }
+            else
+            {
+                integer++;
+            }
+        }
+
+        uart_print_number(integer, 0, ' ', sign);
+
+        if (decimals)
+        {
+            uart_putchar('.');
+
+            for (unsigned char i = 0; i < decimals; i++)
+            {
+                uart_putchar(buffer[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Transmit a zero terminated string from RAM.
+     *
+     * @param data Pointer to the string.
+     */
+    void uart_print(const char *data)
+    {
+        while (*data)
+        {
+            uart_putchar(*data++);
+        }
+    }
+
+    /**
+     * @brief Transmit a zero terminated string from flash memory.
+     *
+     * @param data Pointer to the string in program memory (see PSTR()).
+     */
+    void uart_print_P(PGM_P data)
+    {
+        char temp;
+
+        while ((temp = pgm_read_byte(data++)))
+        {
+            uart_putchar(temp);
+        }
+    }
+
+    /**
+     * @brief Transmit an unsigned integer in decimal notation.
+     *
+     * @param value Value to transmit.
+     * @param width Minimum field width (0 = no padding).
+     * @param fill Padding character (' ' or '0').
+     *
+     * @details
+     * Same output as printf "%lu" with width and fill, e.g. uart_print_unsigned(7, 2, '0') transmits "07".
+     */
+    void uart_print_unsigned(uint32_t value, uint8_t width, char fill)
+    {
+        uart_print_number(value, width, fill, 0);
+    }
+
+    /**
+     * @brief Transmit a signed integer in decimal notation.
+     *
+     * @param value Value to transmit.
+     * @param width Minimum field width including sign (0 = no padding).
+     * @param fill Padding character (' ' or '0').
+     */
+    void uart_print_signed(int32_t value, uint8_t width, char fill)
+    {
+        if (value < 0)
+        {
+            uart_print_number((uint32_t)0 - (uint32_t)value, width, fill, '-');
+            return;
+        }
+        uart_print_number((uint32_t)value, width, fill, 0);
+    }
+
+    /**
+     * @brief Transmit an unsigned integer in hexadecimal notation (uppercase).
+     *
+     * @param value Value to transmit.
+     * @param digits Number of nibbles to transmit (1-8), leading zeros included.
+     */
+    void uart_print_hex(uint32_t value, uint8_t digits)
+    {
+        while (digits--)
+        {
+            unsigned char nibble = (unsigned char)(value >> (digits<<2)) & 0x0F;
+            uart_putchar((char)(nibble < 10 ? ('0' + nibble) : ('A' - 10 + nibble)));
+        }
+    }
+
+    /**
+     * @brief Transmit a decimal scaled integer as decimal fraction.
+     *
+     * @param value Value scaled by 10^decimals (e.g. 2345 with 2 decimals = 23.45).
+     * @param decimals Number of decimal places contained in value (0-9).
+     *
+     * @details
+     * Replaces printf("%d.%02d", value / 100, value % 100) without any division.
+     */
+    void uart_print_decimal(int32_t value, uint8_t decimals)
+    {
+        char buffer[10];
+        uint32_t magnitude = (uint32_t)value;
+        unsigned char length;
+
+        if (value < 0)
+        {
+            uart_putchar('-');
+            magnitude = (uint32_t)0 - magnitude;
+        }
+        length = uart_print_digits(magnitude, buffer);
+
+        // Value below 1, e.g. 5 with 3 decimals = 0.005
+        if (length <= decimals)
+        {
+            uart_putchar('0');
+            uart_putchar('.');
+
+            for (unsigned char i = length; i < decimals; i++)
+            {
+                uart_putchar('0');
+            }
+            decimals = 0;
+        }
+
+        for (unsigned char i = 0; i < length; i++)
+        {
+            if (decimals && i == (unsigned char)(length - decimals))
+            {
+                uart_putchar('.');
+            }
+            uart_putchar(buffer[i]);
+        }
+    }
+
+    /**
+     * @brief Transmit a binary fixed-point (Q-format) number.
+     *
+     * @param value Signed fixed-point value (e.g. Q16.16 or Q8.8 stored in an int32_t).
+     * @param fraction_bits Number of fraction bits of the Q-format (0-28).
+     * @param decimals Number of decimal places to transmit (0-9), last place is rounded.
+     *
+     * @details
+     * Conversion uses shifts and multiplications by 10 only. E.g. uart_print_fixed(0x00018000, 16, 2) transmits "1.50".
+     */
+    void uart_print_fixed(int32_t value, uint8_t fraction_bits, uint8_t decimals)
+    {
+        uint32_t magnitude = (uint32_t)value;
+        char sign = 0;
+
+        if (value < 0)
+        {
+            magnitude = (uint32_t)0 - magnitude;
+            sign = '-';
+        }
+        uart_print_fraction(magnitude >> fraction_bits, magnitude & ((1UL<<fraction_bits) - 1UL), fraction_bits, decimals, sign);
+    }
+
+    /**
+     * @brief Transmit a float value with a fixed number of decimal places.
+     *
+     * @param value Float value to transmit.
+     * @param decimals Number of decimal places to transmit (0-9), last place is rounded.
+     *
+     * @details
+     * The IEEE 754 representation is decomposed into mantissa and exponent and handed to the fixed-point converter, so neither the floating-point vfprintf() variant (libprintf_flt) nor any float arithmetic is linked. Fraction bits below 2^-28 are truncated before rounding.
+     *
+     * @note Magnitudes of 2^32 and above are transmitted as "ovf", NaN as "nan" and infinity as "inf".
+     */
+    void uart_print_float(float value, uint8_t decimals)
+    {
+        union
+        {
+            float value;
+            uint32_t bits;
+        } convert;
+
+        convert.value = value;
+
+        char sign = (convert.bits & 0x80000000UL) ? '-' : 0;
+        int16_t exponent = (int16_t)((convert.bits >> 23) & 0xFF);
+        uint32_t mantissa = convert.bits & 0x007FFFFFUL;
+
+        if (exponent == 0xFF)
+        {
+            if (mantissa)
+            {
+                uart_print_P(PSTR("nan"));
+                return;
+            }
+            if (sign)
+            {
+                uart_putchar(sign);
+            }
+            uart_print_P(PSTR("inf"));
+            return;
+        }
+
+        // Denormals have no hidden bit and the exponent of the smallest normal
+        if (exponent)
+        {
+            mantissa |= 0x00800000UL;
+        }
+        else
+        {
+            exponent = 1;
+        }
+
+        // value = mantissa * 2^shift
+        int16_t shift = exponent - 150;
+
+        if (shift >= 0)
+        {
+            if (shift > 8)
+            {
+                if (sign)
+                {
+                    uart_putchar(sign);
+                }
+                uart_print_P(PSTR("ovf"));
+                return;
+            }
+            uart_print_fraction(mantissa << shift, 0, 0, decimals, sign);
+            return;
+        }
+
+        uint8_t fraction_bits = (uint8_t)(-shift);
+
+        if (fraction_bits > 28)
+        {
+            // Bits below 2^-28 cannot influence 9 decimal places
+            mantissa = (fraction_bits - 28) < 32 ? (mantissa >> (fraction_bits - 28)) : 0;
+            fraction_bits = 28;
+        }
+        uart_print_fraction(mantissa >> fraction_bits, mantissa & ((1UL<<fraction_bits) - 1UL), fraction_bits, decimals, sign);
+    }
+
+#endif
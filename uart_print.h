@@ -0,0 +1,64 @@
+/**
+ * @file uart_print.h
+ * @brief Header file with declarations for formatted UART output without stdio.
+ *
+ * This file provides typed emitters for strings (RAM and flash), signed and unsigned integers and hexadecimal values. Each emitter formats its argument directly onto the UART transmit path, so formatted output does not depend on vfprintf() and its runtime format string parsing.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_PRINT_H_
+#define UART_PRINT_H_
+
+    #include <stdint.h>
+    #include <avr/pgmspace.h>
+
+    #include "uart.h"
+
+    /**
+     * @def UART_PRINT_P
+     * @brief Transmit a string literal that is placed in flash memory.
+     *
+     * @details
+     * Shorthand for uart_print_P(PSTR(s)). The literal never occupies RAM.
+     *
+     * @code
+     * // Equivalent of printf("T=%u.%02u C\n", a, b);
+     * UART_PRINT_P("T=");
+     * uart_print_unsigned(a, 0, ' ');
+     * UART_PRINT_P(".");
+     * uart_print_unsigned(b, 2, '0');
+     * UART_PRINT_P(" C\n");
+     * @endcode
+     */
+    #define UART_PRINT_P(s) uart_print_P(PSTR(s))
+
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+
+    #if !defined(UART_TXCIE) && !defined(UART_UDRIE)
+        void uart_print(const char *data);
+        void uart_print_P(PGM_P data);
+        void uart_print_unsigned(uint32_t value, uint8_t width, char fill);
+        void uart_print_signed(int32_t value, uint8_t width, char fill);
+        void uart_print_hex(uint32_t value, uint8_t digits);
+        void uart_print_decimal(int32_t value, uint8_t decimals);
+        void uart_print_fixed(int32_t value, uint8_t fraction_bits, uint8_t decimals);
+        void uart_print_float(float value, uint8_t decimals);
+    #endif
+
+    #ifdef __cplusplus
+        }
+    #endif
+
+#endif /* UART_PRINT_H_ */
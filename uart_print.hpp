@@ -0,0 +1,404 @@
+/**
+ * @file uart_print.hpp
+ * @brief Header file with the compile-time format front end of the typed print emitters.
+ *
+ * This file provides printf-style output for C++ without vfprintf(). The format string is parsed at compile time into a fixed sequence of literal writes and calls of the uart_print.h emitters, every argument is checked against its conversion and the literal parts are placed in flash memory. The result is the code of hand-written UART_PRINT_P()/uart_print_*() sequences.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_PRINT_HPP_
+#define UART_PRINT_HPP_
+
+    #if __cplusplus < 201703L
+        #error "uart_print.hpp requires C++17 (e.g. avr-g++ -std=gnu++17)"
+    #endif
+
+    #include <stddef.h>
+
+    #include "uart_print.h"
+
+    /**
+     * @defgroup UART_Print_Format UART Compile-Time Format
+     * @brief Format syntax of uart::print() and UART_PRINTF().
+     *
+     * @details
+     * Conversions, a subset of printf(), everything else is rejected at compile time:
+     * - %d, %i: signed integer up to 32 bit, optional '0' flag and width (uart_print_signed())
+     * - %u: unsigned integer up to 32 bit, optional '0' flag and width (uart_print_unsigned())
+     * - %X: unsigned integer up to 32 bit in upper case hexadecimal, width is the number of digits (default all digits of the type, uart_print_hex())
+     * - %c: char
+     * - %s: string in RAM, %S: string in flash memory (avr-libc convention, e.g. PSTR())
+     * - %f: float or double with precision 0-9 (default 6, uart_print_float())
+     * - %%: percent sign
+     *
+     * Length modifiers (h, hh, l) are accepted and ignored, the argument type selects the emitter. A wrong argument type, a missing or a surplus argument is a compile error. Literal parts of more than one character are separate strings in flash memory, single characters are written with uart_putchar().
+     *
+     * @code
+     * UART_PRINTF("T=%u.%02u C\n", a, b);         // C++17
+     * uart::print<"T=%u.%02u C\n">(a, b);          // C++20
+     *
+     * // Same code as
+     * UART_PRINT_P("T=");
+     * uart_print_unsigned(a, 0, ' ');
+     * uart_putchar('.');
+     * uart_print_unsigned(b, 2, '0');
+     * UART_PRINT_P(" C\n");
+     * @endcode
+     */
+    /* @{ */
+
+    /**
+     * @def UART_PRINTF
+     * @brief Print with a compile-time format (C++17).
+     *
+     * @details
+     * Wraps the string literal into a type, so the format is a constant expression for uart::print().
+     */
+    #define UART_PRINTF(format, ...) \
+        ::uart::print([] { struct Format { static constexpr const char *get() { return format; } }; return Format(); }(), ##__VA_ARGS__)
+    /* @} */
+
+    namespace uart
+    {
+        namespace detail
+        {
+            enum class Conversion : unsigned char
+            {
+                End,            // No further conversion
+                Percent,
+                Signed,
+                Unsigned,
+                Hex,
+                Char,
+                String,
+                StringP,
+                Float,
+                Invalid
+            };
+
+            /**
+             * @brief Conversion of the format string.
+             */
+            struct Spec
+            {
+                size_t begin;                   // Position of '%', end of the format for Conversion::End
+                size_t end;                     // Position behind the conversion
+                Conversion conversion;
+                unsigned char width;
+                char fill;
+                unsigned char precision;
+            };
+
+            constexpr bool digit(char data)
+            {
+                return data >= '0' && data <= '9';
+            }
+
+            /**
+             * @brief Find and parse the next conversion at or behind position.
+             */
+            constexpr Spec parse(const char *format, size_t position)
+            {
+                while (format[position] && format[position] != '%')
+                {
+                    position++;
+                }
+
+                Spec spec = { position, position, Conversion::End, 0, ' ', 6 };
+
+                if (!format[position])
+                {
+                    return spec;
+                }
+                position++;
+
+                bool flag = false;
+                unsigned int width = 0;
+                unsigned int precision = 0;
+                bool precise = false;
+
+                if (format[position] == '0')
+                {
+                    spec.fill = '0';
+                    flag = true;
+                    position++;
+                }
+
+                while (digit(format[position]))
+                {
+                    width = width * 10 + (format[position++] - '0');
+                }
+
+                if (format[position] == '.')
+                {
+                    precise = true;
+                    position++;
+
+                    while (digit(format[position]))
+                    {
+                        precision = precision * 10 + (format[position++] - '0');
+                    }
+                }
+
+                while (format[position] == 'h' || format[position] == 'l')
+                {
+                    position++;
+                }
+
+                char type = format[position];
+
+                if (type)
+                {
+                    position++;
+                }
+                spec.end = position;
+                spec.width = (unsigned char)width;
+                spec.precision = precise ? (unsigned char)precision : 6;
+
+                bool plain = !flag && !width && !precise;
+
+                switch (type)
+                {
+                    case '%':
+                        spec.conversion = plain ? Conversion::Percent : Conversion::Invalid;
+                        break;
+                    case 'd':
+                    case 'i':
+                        spec.conversion = (!precise && width <= 255) ? Conversion::Signed : Conversion::Invalid;
+                        break;
+                    case 'u':
+                        spec.conversion = (!precise && width <= 255) ? Conversion::Unsigned : Conversion::Invalid;
+                        break;
+                    case 'X':
+                        spec.conversion = (!precise && width <= 8) ? Conversion::Hex : Conversion::Invalid;
+                        break;
+                    case 'c':
+                        spec.conversion = plain ? Conversion::Char : Conversion::Invalid;
+                        break;
+                    case 's':
+                        spec.conversion = plain ? Conversion::String : Conversion::Invalid;
+                        break;
+                    case 'S':
+                        spec.conversion = plain ? Conversion::StringP : Conversion::Invalid;
+                        break;
+                    case 'f':
+                        spec.conversion = (!flag && !width && precision <= 9) ? Conversion::Float : Conversion::Invalid;
+                        break;
+                    default:
+                        spec.conversion = Conversion::Invalid;
+                        break;
+                }
+                return spec;
+            }
+
+            // avr-libc has no C++ standard library, so the few traits are defined here
+            template<typename T, typename U> struct Same { static constexpr bool value = false; };
+            template<typename T> struct Same<T, T> { static constexpr bool value = true; };
+
+            template<typename T>
+            constexpr bool signed_integer = Same<T, signed char>::value || Same<T, short>::value || Same<T, int>::value || (Same<T, long>::value && sizeof(long) <= 4);
+
+            template<typename T>
+            constexpr bool unsigned_integer = Same<T, unsigned char>::value || Same<T, unsigned short>::value || Same<T, unsigned int>::value || (Same<T, unsigned long>::value && sizeof(unsigned long) <= 4);
+
+            /**
+             * @brief Check an argument type against its conversion.
+             */
+            template<typename T>
+            constexpr bool accepts(Conversion conversion)
+            {
+                switch (conversion)
+                {
+                    case Conversion::Signed:
+                        return signed_integer<T>;
+                    case Conversion::Unsigned:
+                    case Conversion::Hex:
+                        return unsigned_integer<T>;
+                    case Conversion::Char:
+                        return Same<T, char>::value;
+                    case Conversion::String:
+                    case Conversion::StringP:
+                        return Same<T, const char *>::value || Same<T, char *>::value;
+                    case Conversion::Float:
+                        return Same<T, float>::value || Same<T, double>::value;
+                    default:
+                        return false;
+                }
+            }
+
+            template<size_t... I> struct Indices {};
+            template<size_t N, size_t... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+            template<size_t... I> struct MakeIndices<0, I...> { using type = Indices<I...>; };
+
+            /**
+             * @brief Literal part of the format in flash memory.
+             */
+            template<typename Format, size_t Begin, typename Sequence> struct Literal;
+
+            template<typename Format, size_t Begin, size_t... I>
+            struct Literal<Format, Begin, Indices<I...>>
+            {
+                static constexpr char text[sizeof...(I) + 1] PROGMEM = { Format::get()[Begin + I]..., '\0' };
+            };
+
+            template<typename Format, size_t Begin, size_t End>
+            inline void literal()
+            {
+                if constexpr (End - Begin == 1)
+                {
+                    uart_putchar(Format::get()[Begin]);
+                }
+                else if constexpr (End > Begin)
+                {
+                    uart_print_P(Literal<Format, Begin, typename MakeIndices<End - Begin>::type>::text);
+                }
+            }
+
+            template<typename Format, size_t Position>
+            inline void emit()
+            {
+                constexpr Spec spec = parse(Format::get(), Position);
+
+                literal<Format, Position, spec.begin>();
+
+                if constexpr (spec.conversion == Conversion::Percent)
+                {
+                    uart_putchar('%');
+                    emit<Format, spec.end>();
+                }
+                else
+                {
+                    static_assert(spec.conversion != Conversion::Invalid, "uart::print: invalid or unsupported conversion");
+                    static_assert(spec.conversion == Conversion::End || spec.conversion == Conversion::Invalid, "uart::print: too few arguments");
+                }
+            }
+
+            template<typename Format, size_t Position, typename Argument, typename... Arguments>
+            inline void emit(Argument argument, Arguments... arguments)
+            {
+                constexpr Spec spec = parse(Format::get(), Position);
+
+                literal<Format, Position, spec.begin>();
+
+                if constexpr (spec.conversion == Conversion::Percent)
+                {
+                    uart_putchar('%');
+                    emit<Format, spec.end>(argument, arguments...);
+                }
+                else if constexpr (spec.conversion == Conversion::Invalid)
+                {
+                    static_assert(spec.conversion != Conversion::Invalid, "uart::print: invalid or unsupported conversion");
+                }
+                else if constexpr (spec.conversion == Conversion::End)
+                {
+                    static_assert(spec.conversion != Conversion::End, "uart::print: too many arguments");
+                }
+                else if constexpr (!accepts<Argument>(spec.conversion))
+                {
+                    static_assert(accepts<Argument>(spec.conversion), "uart::print: argument type does not match its conversion");
+                }
+                else
+                {
+                    if constexpr (spec.conversion == Conversion::Signed)
+                    {
+                        uart_print_signed(argument, spec.width, spec.fill);
+                    }
+                    else if constexpr (spec.conversion == Conversion::Unsigned)
+                    {
+                        uart_print_unsigned(argument, spec.width, spec.fill);
+                    }
+                    else if constexpr (spec.conversion == Conversion::Hex)
+                    {
+                        uart_print_hex(argument, spec.width ? spec.width : sizeof(Argument) * 2);
+                    }
+                    else if constexpr (spec.conversion == Conversion::Char)
+                    {
+                        uart_putchar(argument);
+                    }
+                    else if constexpr (spec.conversion == Conversion::String)
+                    {
+                        uart_print(argument);
+                    }
+                    else if constexpr (spec.conversion == Conversion::StringP)
+                    {
+                        uart_print_P(argument);
+                    }
+                    else
+                    {
+                        uart_print_float((float)argument, spec.precision);
+                    }
+
+                    emit<Format, spec.end>(arguments...);
+                }
+            }
+        }
+
+        /**
+         * @brief Print with a compile-time format, see UART_PRINTF().
+         *
+         * @param format Type whose static constexpr get() returns the format string.
+         * @param arguments Arguments of the conversions.
+         */
+        template<typename Format, typename... Arguments>
+        inline void print(Format format, Arguments... arguments)
+        {
+            (void)format;
+            detail::emit<Format, 0>(arguments...);
+        }
+
+        #if __cplusplus >= 202002L
+            /**
+             * @brief String literal as template argument of uart::print<"...">().
+             */
+            template<size_t N>
+            struct Text
+            {
+                char data[N];
+
+                constexpr Text(const char (&text)[N])
+                    : data()
+                {
+                    for (size_t i = 0; i < N; i++)
+                    {
+                        data[i] = text[i];
+                    }
+                }
+            };
+
+            template<Text T>
+            struct TextFormat
+            {
+                static constexpr const char *get()
+                {
+                    return T.data;
+                }
+            };
+
+            /**
+             * @brief Print with a compile-time format (C++20).
+             *
+             * @param arguments Arguments of the conversions.
+             *
+             * @code
+             * uart::print<"%s: %d\n">(name, value);
+             * @endcode
+             */
+            template<Text T, typename... Arguments>
+            inline void print(Arguments... arguments)
+            {
+                detail::emit<TextFormat<T>, 0>(arguments...);
+            }
+        #endif
+    }
+
+#endif /* UART_PRINT_HPP_ */
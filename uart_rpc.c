@@ -0,0 +1,155 @@
+/**
+ * @file uart_rpc.c
+ * @brief Source file with implementation of the request/response RPC layer on top of UART frames.
+ *
+ * This file contains the request parser and dispatcher. Complete request frames are taken from the frame receive queue, every message is dispatched through the method table in flash memory and its response is written as frame payload, coalesced with the other responses of the same batch.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_rpc.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_rpc.h"
+
+static const UART_RPC_Method *uart_rpc_methods;             // Method table in flash memory
+static uint8_t uart_rpc_count;
+static uint8_t uart_rpc_request[UART_FRAME_RX_MAX];
+static uint8_t uart_rpc_response[UART_RPC_HEADER + UART_RPC_RESULT_MAX];
+
+/**
+ * @brief Register the method table.
+ *
+ * @param methods Method table in flash memory (PROGMEM), the method number of a request is its index.
+ * @param count Number of table entries.
+ *
+ * @code
+ * static uint8_t rpc_echo(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size)
+ * {
+ *     memcpy(result, args, length);
+ *     *size = length;
+ *     return UART_RPC_OK;
+ * }
+ *
+ * static const UART_RPC_Method rpc_methods[] PROGMEM = { rpc_echo };
+ *
+ * uart_rpc_init(rpc_methods, sizeof(rpc_methods) / sizeof(rpc_methods[0]));
+ * @endcode
+ */
+void uart_rpc_init(const UART_RPC_Method *methods, uint8_t count)
+{
+    uart_rpc_methods = methods;
+    uart_rpc_count = count;
+}
+
+/**
+ * @brief Call a method and send its response.
+ *
+ * @param id Request ID.
+ * @param method Method number.
+ * @param args Argument bytes.
+ * @param length Number of argument bytes.
+ */
+static void uart_rpc_dispatch(uint8_t id, uint8_t method, const uint8_t *args, uint8_t length)
+{
+    uint8_t size = 0;
+    uint8_t status = UART_RPC_UNKNOWN;
+
+    if (method < uart_rpc_count)
+    {
+        UART_RPC_Method handler = (UART_RPC_Method)pgm_read_ptr(&uart_rpc_methods[method]);
+
+        // The result is written in place behind the response header
+        status = handler(id, args, length, &uart_rpc_response[UART_RPC_HEADER], &size);
+
+        if (status == UART_RPC_DEFERRED)
+        {
+            return;
+        }
+
+        if (size > UART_RPC_RESULT_MAX)
+        {
+            size = UART_RPC_RESULT_MAX;
+        }
+    }
+
+    uart_rpc_response[0] = id;
+    uart_rpc_response[1] = status;
+    uart_rpc_response[2] = size;
+
+    uart_frame_write(uart_rpc_response, UART_RPC_HEADER + size);
+}
+
+/**
+ * @brief Process all received request frames.
+ *
+ * @return Number of dispatched requests.
+ *
+ * @details
+ * Called from the main loop (e.g. after the uart_frame_notify() callback has set a flag). The responses of a frame are written with uart_frame_write(), with UART_FRAME_COALESCE they leave as one frame when the batch is complete.
+ *
+ * @note Arguments are only valid during the method call, a deferred method has to copy what it needs.
+ */
+uint8_t uart_rpc_process(void)
+{
+    uint8_t handled = 0;
+    uint16_t length;
+
+    while (uart_frame_read(uart_rpc_request, sizeof(uart_rpc_request), &length) != UART_Empty)
+    {
+        const uint8_t *message = uart_rpc_request;
+
+        while (length >= UART_RPC_HEADER)
+        {
+            uint8_t size = message[2];
+
+            length -= UART_RPC_HEADER;
+
+            if (size > length)
+            {
+                uart_rpc_respond(message[0], UART_RPC_MALFORMED, NULL, 0);
+                break;
+            }
+
+            uart_rpc_dispatch(message[0], message[1], &message[UART_RPC_HEADER], size);
+            handled++;
+
+            message += UART_RPC_HEADER + size;
+            length -= size;
+        }
+
+        uart_frame_flush();
+    }
+    return handled;
+}
+
+/**
+ * @brief Send the response of a request.
+ *
+ * @param id Request ID.
+ * @param status UART_RPC_OK, UART_RPC_ERROR or a method specific status.
+ * @param result Result bytes (NULL if length is 0).
+ * @param length Number of result bytes.
+ * @return 0 on success, 1 if the frame has been discarded.
+ *
+ * @details
+ * Completes a request whose method returned UART_RPC_DEFERRED. Responses do not have to follow the request order, the host matches them by ID.
+ *
+ * @note Frame functions are meant for one context, call it from the main loop and not from an ISR.
+ */
+char uart_rpc_respond(uint8_t id, uint8_t status, const void *result, uint8_t length)
+{
+    uint8_t header[UART_RPC_HEADER] = { id, status, length };
+
+    uart_frame_begin(UART_RPC_HEADER + length);
+    uart_frame_put(header, UART_RPC_HEADER);
+    uart_frame_put(result, length);
+    return uart_frame_end();
+}
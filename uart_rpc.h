@@ -0,0 +1,114 @@
+/**
+ * @file uart_rpc.h
+ * @brief Header file with declarations of the request/response RPC layer on top of UART frames.
+ *
+ * This file provides a compact binary RPC protocol. Every request carries an ID that is returned with its response, so the host can send many requests without waiting and match the responses in any order. Methods are dispatched through a method table in flash memory.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_RPC_H_
+#define UART_RPC_H_
+
+    /**
+     * @defgroup UART_RPC UART RPC Macros
+     * @brief Configuration macros and status codes of the RPC layer.
+     *
+     * @details
+     * Requests and responses are messages inside frames (see @ref UART_Framing). A frame payload holds one or more messages back to back, so a host can pipeline a batch of requests in one frame and the responses of a batch are coalesced into one frame (UART_FRAME_COALESCE).
+     *
+     * Request:  ID (1 byte), method (1 byte), argument length (1 byte), arguments.
+     * Response: ID (1 byte), status (1 byte), result length (1 byte), result.
+     *
+     * Multi-byte values inside arguments and results are little-endian (native AVR byte order).
+     */
+    /* @{ */
+    #ifndef UART_RPC_RESULT_MAX
+        /**
+         * @def UART_RPC_RESULT_MAX
+         * @brief Size of the result buffer handed to a method in bytes (default 32, max 255).
+         */
+        #define UART_RPC_RESULT_MAX 32
+    #endif
+
+    #if UART_RPC_RESULT_MAX < 1 || UART_RPC_RESULT_MAX > 255
+        #error "UART_RPC_RESULT_MAX has to be 1-255"
+    #endif
+
+    /**
+     * @def UART_RPC_HEADER
+     * @brief Size of the request/response header in bytes.
+     */
+    #define UART_RPC_HEADER 3
+
+    /**
+     * @def UART_RPC_OK
+     * @brief Status: method completed, the result is valid.
+     */
+    #define UART_RPC_OK 0
+
+    /**
+     * @def UART_RPC_ERROR
+     * @brief Status: method failed (the result may carry a method specific error code).
+     */
+    #define UART_RPC_ERROR 1
+
+    /**
+     * @def UART_RPC_UNKNOWN
+     * @brief Status: method number not in the method table.
+     */
+    #define UART_RPC_UNKNOWN 2
+
+    /**
+     * @def UART_RPC_MALFORMED
+     * @brief Status: argument length exceeds the frame, the rest of the frame is ignored.
+     */
+    #define UART_RPC_MALFORMED 3
+
+    /**
+     * @def UART_RPC_DEFERRED
+     * @brief Method return value: no response now, the method answers later with uart_rpc_respond().
+     *
+     * @details
+     * Lets slow methods (e.g. an ADC conversion or an EEPROM write) complete in the background while later requests are answered first.
+     */
+    #define UART_RPC_DEFERRED 0xFF
+    /* @} */
+
+    #include <stdint.h>
+    #include <avr/pgmspace.h>
+
+    #include "uart.h"
+
+    #if UART_FRAME == 0 || UART_FRAME_RX == 0
+        #error "uart_rpc requires UART_FRAME > 0 and UART_FRAME_RX > 0"
+    #elif UART_FRAME_RX_MAX < UART_RPC_HEADER || (UART_RPC_HEADER + UART_RPC_RESULT_MAX) > ((UART_FRAME_LENGTH_BYTES == 1) ? 255 : 65535)
+        #error "UART_FRAME_RX_MAX/UART_RPC_RESULT_MAX do not fit the frame length"
+    #endif
+
+    /**
+     * @brief RPC method.
+     *
+     * @param id Request ID (needed for uart_rpc_respond() of a deferred response).
+     * @param args Argument bytes.
+     * @param length Number of argument bytes.
+     * @param[out] result Result buffer of UART_RPC_RESULT_MAX bytes.
+     * @param[in,out] size Result length, 0 on entry.
+     * @return UART_RPC_OK, UART_RPC_ERROR, a method specific status or UART_RPC_DEFERRED.
+     */
+    typedef uint8_t (*UART_RPC_Method)(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size);
+
+    void uart_rpc_init(const UART_RPC_Method *methods, uint8_t count);
+    uint8_t uart_rpc_process(void);
+    char uart_rpc_respond(uint8_t id, uint8_t status, const void *result, uint8_t length);
+
+#endif /* UART_RPC_H_ */
@@ -0,0 +1,375 @@
+/**
+ * @file uart_supervisor.c
+ * @brief Source file with implementation of the link supervisor.
+ *
+ * This file contains the port state, the heartbeat timers and the failover decision. All timing is counted in uart_supervisor_tick() periods, the ports are only accessed through their operations.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_supervisor.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_supervisor.h"
+
+#include <util/atomic.h>
+
+/**
+ * @brief State of a supervised port.
+ */
+static struct uart_supervisor_link
+{
+    const UART_Supervisor_Port *port;
+    uint16_t silence;                                       // Ticks since the last peer traffic
+    uint8_t idle;                                           // Ticks since the last own traffic
+    uint8_t errors;                                         // Receive errors in the current window
+    uint8_t faulty;                                         // Error limit reached in the last window
+} uart_supervisor_links[UART_SUPERVISOR_PORTS];
+
+static uint8_t uart_supervisor_count;
+static uint8_t uart_supervisor_active;
+static uint8_t uart_supervisor_window;                      // Ticks of the current error window
+static void (*uart_supervisor_callback)(uint8_t port);
+
+static const uint8_t uart_supervisor_heartbeat[] = { UART_SUPERVISOR_ID, UART_SUPERVISOR_STATUS, 0 };
+
+#if UART_FRAME_RX > 0
+    /**
+     * @brief Read a byte over this driver while the frame receiver owns the received bytes.
+     *
+     * @param[out] data Unused.
+     * @return UART_Empty.
+     */
+    static UART_Data uart_supervisor_uart_read(char *data)
+    {
+        (void)data;
+        return UART_Empty;
+    }
+
+    const UART_Supervisor_Port uart_supervisor_uart = { uart_frame_write, uart_supervisor_uart_read, uart_error_flags, uart_tx_active };
+#elif UART_FRAME > 0
+    const UART_Supervisor_Port uart_supervisor_uart = { uart_frame_write, uart_scanchar, uart_error_flags, uart_tx_active };
+#else
+    /**
+     * @brief Send a message over this driver without framing.
+     *
+     * @param data Message.
+     * @param length Length of the message (max 255).
+     * @return 0 on success, 1 if the message has not been sent completely.
+     */
+    static char uart_supervisor_uart_write(const void *data, uint16_t length)
+    {
+        if (length > 255)
+        {
+            return 1;
+        }
+        return uart_write((const char *)data, (unsigned char)length);
+    }
+
+    const UART_Supervisor_Port uart_supervisor_uart = { uart_supervisor_uart_write, uart_scanchar, uart_error_flags, uart_tx_active };
+#endif
+
+/**
+ * @brief Check if a port can carry the traffic.
+ *
+ * @param link Port state.
+ * @return 1 if the peer is alive and the port is not faulty, otherwise 0.
+ */
+static uint8_t uart_supervisor_usable(const struct uart_supervisor_link *link)
+{
+    uint16_t silence;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        silence = link->silence;
+    }
+    return silence < UART_SUPERVISOR_TIMEOUT && !link->faulty;
+}
+
+/**
+ * @brief Register the supervised ports.
+ *
+ * @param ports Ports in order of preference, ports[0] is the primary port.
+ * @param count Number of ports (max UART_SUPERVISOR_PORTS).
+ *
+ * @details
+ * All peers count as dead until their first traffic, the primary port is active.
+ *
+ * @code
+ * static const UART_Supervisor_Port *const supervisor_ports[] = { &uart_supervisor_uart, &soft_uart_port };
+ *
+ * uart_supervisor_init(supervisor_ports, 2);
+ * @endcode
+ */
+void uart_supervisor_init(const UART_Supervisor_Port *const *ports, uint8_t count)
+{
+    if (count > UART_SUPERVISOR_PORTS)
+    {
+        count = UART_SUPERVISOR_PORTS;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            struct uart_supervisor_link *link = &uart_supervisor_links[i];
+
+            link->port = ports[i];
+            link->silence = UART_SUPERVISOR_TIMEOUT;
+            link->idle = 0;
+            link->errors = 0;
+            link->faulty = 0;
+        }
+
+        uart_supervisor_count = count;
+        uart_supervisor_active = 0;
+        uart_supervisor_window = 0;
+    }
+}
+
+/**
+ * @brief Send a message over the active port.
+ *
+ * @param data Message.
+ * @param length Length of the message.
+ * @return Return value of the port, 1 without ports.
+ */
+char uart_supervisor_write(const void *data, uint16_t length)
+{
+    if (!uart_supervisor_count)
+    {
+        return 1;
+    }
+
+    struct uart_supervisor_link *link = &uart_supervisor_links[uart_supervisor_active];
+
+    link->idle = 0;
+    return link->port->write(data, length);
+}
+
+/**
+ * @brief Read a byte from any port.
+ *
+ * @param[out] data Received byte.
+ * @return UART_Received, UART_Empty if no port has data or UART_Fault on a receive error.
+ *
+ * @details
+ * The active port is read first, the other ports are drained as well, so a peer that already switched over is not lost. Every received byte counts as peer traffic of its port and every fault as receive error.
+ */
+UART_Data uart_supervisor_read(char *data)
+{
+    for (uint8_t i = 0; i < uart_supervisor_count; i++)
+    {
+        uint8_t index = uart_supervisor_active + i;
+
+        if (index >= uart_supervisor_count)
+        {
+            index -= uart_supervisor_count;
+        }
+
+        struct uart_supervisor_link *link = &uart_supervisor_links[index];
+        UART_Data status = link->port->read(data);
+
+        if (status == UART_Received)
+        {
+            uart_supervisor_alive(index);
+            return status;
+        }
+        else if (status == UART_Fault)
+        {
+            if (link->errors < 0xFF)
+            {
+                link->errors++;
+            }
+            return status;
+        }
+    }
+    return UART_Empty;
+}
+
+/**
+ * @brief Report peer traffic that has not been read with uart_supervisor_read().
+ *
+ * @param port Port number.
+ *
+ * @details
+ * For traffic that is consumed elsewhere, e.g. frames of the RPC layer. May be called from an ISR (e.g. the uart_frame_notify() callback).
+ */
+void uart_supervisor_alive(uint8_t port)
+{
+    if (port < uart_supervisor_count)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            uart_supervisor_links[port].silence = 0;
+        }
+    }
+}
+
+/**
+ * @brief Advance the supervisor by one period.
+ *
+ * @details
+ * Called periodically from the main loop, not from an ISR. Sends due heartbeats, collects the receive errors, ends the error window and selects the active port. The callback of uart_supervisor_notify() is called after a switch.
+ */
+void uart_supervisor_tick(void)
+{
+    uint8_t window = 0;
+
+    if (++uart_supervisor_window >= UART_SUPERVISOR_ERROR_WINDOW)
+    {
+        uart_supervisor_window = 0;
+        window = 1;
+    }
+
+    for (uint8_t i = 0; i < uart_supervisor_count; i++)
+    {
+        struct uart_supervisor_link *link = &uart_supervisor_links[i];
+
+        // Traffic sent past uart_supervisor_write() also keeps the peer informed
+        if (link->port->active && link->port->active())
+        {
+            link->idle = 0;
+        }
+
+        if (++link->idle >= UART_SUPERVISOR_HEARTBEAT)
+        {
+            link->idle = 0;
+            link->port->write(uart_supervisor_heartbeat, sizeof(uart_supervisor_heartbeat));
+        }
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (link->silence < UART_SUPERVISOR_TIMEOUT)
+            {
+                link->silence++;
+            }
+        }
+
+        // The latch holds one error, the count is a lower bound
+        if (link->port->error() != UART_None && link->errors < 0xFF)
+        {
+            link->errors++;
+        }
+
+        if (window)
+        {
+            link->faulty = (link->errors >= UART_SUPERVISOR_ERROR_LIMIT);
+            link->errors = 0;
+        }
+    }
+
+    // Lowest usable port, the primary port takes the traffic back after its recovery
+    for (uint8_t i = 0; i < uart_supervisor_count; i++)
+    {
+        if (uart_supervisor_usable(&uart_supervisor_links[i]))
+        {
+            if (i != uart_supervisor_active)
+            {
+                uart_supervisor_active = i;
+
+                if (uart_supervisor_callback)
+                {
+                    uart_supervisor_callback(i);
+                }
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Get the active port.
+ *
+ * @return Number of the port that carries the traffic of uart_supervisor_write().
+ */
+uint8_t uart_supervisor_port(void)
+{
+    return uart_supervisor_active;
+}
+
+/**
+ * @brief Get the status of a port.
+ *
+ * @param port Port number.
+ * @return UART_SUPERVISOR_ALIVE, UART_SUPERVISOR_FAULTY and UART_SUPERVISOR_ACTIVE flags, 0 for an unknown port.
+ */
+uint8_t uart_supervisor_status(uint8_t port)
+{
+    if (port >= uart_supervisor_count)
+    {
+        return 0;
+    }
+
+    const struct uart_supervisor_link *link = &uart_supervisor_links[port];
+    uint8_t status = 0;
+    uint16_t silence;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        silence = link->silence;
+    }
+
+    if (silence < UART_SUPERVISOR_TIMEOUT)
+    {
+        status |= UART_SUPERVISOR_ALIVE;
+    }
+
+    if (link->faulty)
+    {
+        status |= UART_SUPERVISOR_FAULTY;
+    }
+
+    if (port == uart_supervisor_active)
+    {
+        status |= UART_SUPERVISOR_ACTIVE;
+    }
+    return status;
+}
+
+/**
+ * @brief Set the failover callback.
+ *
+ * @param callback Called from uart_supervisor_tick() with the new active port (NULL = none).
+ */
+void uart_supervisor_notify(void (*callback)(uint8_t port))
+{
+    uart_supervisor_callback = callback;
+}
+
+#if UART_FRAME_RX > 0
+    /**
+     * @brief RPC method as heartbeat of the host.
+     *
+     * @param id Request ID.
+     * @param args Unused.
+     * @param length Number of argument bytes.
+     * @param[out] result Active port (1 byte).
+     * @param[in,out] size Result length.
+     * @return UART_RPC_OK.
+     *
+     * @details
+     * Entry for the method table of uart_rpc_init(), RPC requests arrive over this driver, so the call counts as peer traffic of the port uart_supervisor_uart.
+     */
+    uint8_t uart_supervisor_method(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size)
+    {
+        for (uint8_t i = 0; i < uart_supervisor_count; i++)
+        {
+            if (uart_supervisor_links[i].port == &uart_supervisor_uart)
+            {
+                uart_supervisor_alive(i);
+            }
+        }
+
+        result[0] = uart_supervisor_active;
+        *size = 1;
+        return UART_RPC_OK;
+    }
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file uart_supervisor.h
+ * @brief Header file with declarations of the link supervisor.
+ *
+ * This file provides heartbeats, peer liveness and error rate tracking for one or more serial ports and switches the traffic to a standby port when the active link fails. A dead link is detected after UART_SUPERVISOR_TIMEOUT ticks without peer traffic instead of with the first command timeout.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_SUPERVISOR_H_
+#define UART_SUPERVISOR_H_
+
+    /**
+     * @defgroup UART_Supervisor UART Link Supervisor Macros
+     * @brief Configuration macros, status flags and heartbeat layout of the link supervisor.
+     *
+     * @details
+     * A port is a set of operations (UART_Supervisor_Port), uart_supervisor_uart is the port of this driver. ATmega8/16/32 have a single USART, a standby port is supplied by the application (e.g. a software UART or an external UART), on parts with several USARTs it wraps the driver of the other USART.
+     *
+     * uart_supervisor_tick() is called periodically from the main loop (e.g. every 100 ms) and per port
+     * - sends a heartbeat after UART_SUPERVISOR_HEARTBEAT ticks without own traffic (uart_supervisor_write() or the activity operation of the port),
+     * - counts the peer as alive while its last traffic is less than UART_SUPERVISOR_TIMEOUT ticks ago,
+     * - counts the port as faulty while the receive errors of the last UART_SUPERVISOR_ERROR_WINDOW ticks reached UART_SUPERVISOR_ERROR_LIMIT.
+     *
+     * A port is usable if its peer is alive and it is not faulty. Traffic of uart_supervisor_write() goes to the active port, which is the usable port with the lowest number, so the traffic returns to the primary port as soon as it recovers. If no port is usable the active port is kept.
+     *
+     * With UART_FRAME_RX > 0 the frame receiver consumes all received bytes, the read operation of uart_supervisor_uart always returns UART_Empty. Peer traffic of this port is then reported with uart_supervisor_alive() (e.g. from the uart_frame_notify() callback) or by the host calling uart_supervisor_method().
+     *
+     * Heartbeat: message with the layout of an RPC response (see @ref UART_RPC), ID (UART_SUPERVISOR_ID), status (UART_SUPERVISOR_STATUS), length 0. A host RPC client receives it as unsolicited message, the ID has to be reserved there.
+     */
+    /* @{ */
+    #ifndef UART_SUPERVISOR_PORTS
+        /**
+         * @def UART_SUPERVISOR_PORTS
+         * @brief Maximum number of supervised ports (default 2, max 8).
+         */
+        #define UART_SUPERVISOR_PORTS 2
+    #endif
+
+    #ifndef UART_SUPERVISOR_HEARTBEAT
+        /**
+         * @def UART_SUPERVISOR_HEARTBEAT
+         * @brief Ticks without own traffic until a heartbeat is sent (default 10, 1-255).
+         */
+        #define UART_SUPERVISOR_HEARTBEAT 10
+    #endif
+
+    #ifndef UART_SUPERVISOR_TIMEOUT
+        /**
+         * @def UART_SUPERVISOR_TIMEOUT
+         * @brief Ticks without peer traffic until the peer is considered dead (default 30, 1-65535).
+         *
+         * @note Has to be longer than the heartbeat period of the peer.
+         */
+        #define UART_SUPERVISOR_TIMEOUT 30
+    #endif
+
+    #ifndef UART_SUPERVISOR_ERROR_WINDOW
+        /**
+         * @def UART_SUPERVISOR_ERROR_WINDOW
+         * @brief Length of the error counting window in ticks (default 10, 1-255).
+         */
+        #define UART_SUPERVISOR_ERROR_WINDOW 10
+    #endif
+
+    #ifndef UART_SUPERVISOR_ERROR_LIMIT
+        /**
+         * @def UART_SUPERVISOR_ERROR_LIMIT
+         * @brief Receive errors per window that make a port faulty (default 4, 1-255).
+         */
+        #define UART_SUPERVISOR_ERROR_LIMIT 4
+    #endif
+
+    #ifndef UART_SUPERVISOR_ID
+        /**
+         * @def UART_SUPERVISOR_ID
+         * @brief Message ID of heartbeats (default 0xFE).
+         */
+        #define UART_SUPERVISOR_ID 0xFE
+    #endif
+
+    #if UART_SUPERVISOR_PORTS < 1 || UART_SUPERVISOR_PORTS > 8
+        #error "UART_SUPERVISOR_PORTS has to be 1-8"
+    #endif
+
+    #if UART_SUPERVISOR_HEARTBEAT < 1 || UART_SUPERVISOR_HEARTBEAT > 255 || UART_SUPERVISOR_ERROR_WINDOW < 1 || UART_SUPERVISOR_ERROR_WINDOW > 255 || UART_SUPERVISOR_ERROR_LIMIT < 1 || UART_SUPERVISOR_ERROR_LIMIT > 255
+        #error "UART_SUPERVISOR_HEARTBEAT/UART_SUPERVISOR_ERROR_WINDOW/UART_SUPERVISOR_ERROR_LIMIT have to be 1-255"
+    #endif
+
+    #if UART_SUPERVISOR_TIMEOUT < 1 || UART_SUPERVISOR_TIMEOUT > 65535
+        #error "UART_SUPERVISOR_TIMEOUT has to be 1-65535"
+    #endif
+
+    /**
+     * @def UART_SUPERVISOR_STATUS
+     * @brief Status byte of heartbeats (unsolicited message).
+     */
+    #define UART_SUPERVISOR_STATUS 0x80
+
+    /**
+     * @def UART_SUPERVISOR_ALIVE
+     * @brief Port status: peer traffic within UART_SUPERVISOR_TIMEOUT.
+     */
+    #define UART_SUPERVISOR_ALIVE 0x01
+
+    /**
+     * @def UART_SUPERVISOR_FAULTY
+     * @brief Port status: error limit reached in the last window.
+     */
+    #define UART_SUPERVISOR_FAULTY 0x02
+
+    /**
+     * @def UART_SUPERVISOR_ACTIVE
+     * @brief Port status: port carries the traffic of uart_supervisor_write().
+     */
+    #define UART_SUPERVISOR_ACTIVE 0x04
+    /* @} */
+
+    #include <stdint.h>
+
+    #include "uart.h"
+
+    #if defined(UART_TXCIE) || defined(UART_UDRIE) || defined(UART_RXCIE)
+        #error "uart_supervisor requires the transmit and receive functions (UART_TXCIE/UART_UDRIE/UART_RXCIE not defined)"
+    #endif
+
+    /**
+     * @brief Operations of a supervised port.
+     */
+    typedef struct
+    {
+        char (*write)(const void *data, uint16_t length);   /**< Send one message, 0 = sent/queued (uart_frame_write() semantics) */
+        UART_Data (*read)(char *data);                      /**< Read one byte without blocking (uart_scanchar() semantics) */
+        UART_Error (*error)(void);                          /**< Read and clear the latched receive error (uart_error_flags() semantics) */
+        unsigned char (*active)(void);                      /**< Read and clear the own transmit activity (uart_tx_active() semantics), NULL if all traffic goes through uart_supervisor_write() */
+    } UART_Supervisor_Port;
+
+    extern const UART_Supervisor_Port uart_supervisor_uart;
+
+    void uart_supervisor_init(const UART_Supervisor_Port *const *ports, uint8_t count);
+    char uart_supervisor_write(const void *data, uint16_t length);
+    UART_Data uart_supervisor_read(char *data);
+    void uart_supervisor_alive(uint8_t port);
+    void uart_supervisor_tick(void);
+    uint8_t uart_supervisor_port(void);
+    uint8_t uart_supervisor_status(uint8_t port);
+    void uart_supervisor_notify(void (*callback)(uint8_t port));
+
+    #if UART_FRAME_RX > 0
+        #include "uart_rpc.h"
+
+        uint8_t uart_supervisor_method(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size);
+    #endif
+
+#endif /* UART_SUPERVISOR_H_ */
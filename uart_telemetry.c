@@ -0,0 +1,256 @@
+/**
+ * @file uart_telemetry.c
+ * @brief Source file with implementation of the periodic telemetry scheduler.
+ *
+ * This file contains the channel table and the scheduler. Every call of uart_telemetry_process() samples the due channels round robin into one message of at most UART_TELEMETRY_MESSAGE_MAX record bytes and hands it to uart_frame_write(), so a burst of due channels is spread over several calls instead of stalling the main loop.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see uart_telemetry.h for declarations.
+ * @see [https://github.com/0x007e/hal-avr-mega](https://github.com/0x007e/hal-avr-mega) "AVR ATmega GitHub Repository"
+ */
+
+#include "uart_telemetry.h"
+
+#include <util/atomic.h>
+
+/**
+ * @brief Registered variable.
+ */
+static struct uart_telemetry_channel
+{
+    const volatile uint8_t *address;
+    uint16_t period;                                        // Sample period in uart_telemetry_tick() periods, 0 = off
+    uint16_t due;                                           // Time of the next sample
+    uint8_t encoding;
+} uart_telemetry_channels[UART_TELEMETRY_CHANNELS];
+
+static uint8_t uart_telemetry_count;
+static uint8_t uart_telemetry_next;                         // Channel the next round robin pass starts at
+static volatile uint16_t uart_telemetry_time;
+static uint16_t uart_telemetry_lost_count;
+static uint8_t uart_telemetry_message[UART_TELEMETRY_HEADER + UART_TELEMETRY_MESSAGE_MAX];
+
+/**
+ * @brief Read the telemetry time.
+ *
+ * @return uart_telemetry_tick() count.
+ */
+static uint16_t uart_telemetry_now(void)
+{
+    uint16_t now;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        now = uart_telemetry_time;
+    }
+    return now;
+}
+
+/**
+ * @brief Register a variable.
+ *
+ * @param address Address of the variable, it has to stay valid (global or static).
+ * @param encoding UART_TELEMETRY_U8, UART_TELEMETRY_S16, UART_TELEMETRY_FLOAT, ...
+ * @param period Sample period in uart_telemetry_tick() periods (0 = off, max UART_TELEMETRY_PERIOD_MAX).
+ * @return Channel number, UART_TELEMETRY_INVALID if all channels are in use, the size code of the encoding is 3 or the period is too long.
+ *
+ * @details
+ * Channels are numbered in registration order, the host identifies a variable by its channel number. The first sample is taken with the next uart_telemetry_process().
+ *
+ * @code
+ * static volatile int16_t temperature;
+ *
+ * uart_telemetry_add(&temperature, UART_TELEMETRY_S16, 100);
+ * @endcode
+ */
+uint8_t uart_telemetry_add(const volatile void *address, uint8_t encoding, uint16_t period)
+{
+    // Size code 3 would be an 8 byte value
+    if (uart_telemetry_count >= UART_TELEMETRY_CHANNELS || (encoding & UART_TELEMETRY_SIZE) == UART_TELEMETRY_SIZE || period > UART_TELEMETRY_PERIOD_MAX)
+    {
+        return UART_TELEMETRY_INVALID;
+    }
+
+    struct uart_telemetry_channel *channel = &uart_telemetry_channels[uart_telemetry_count];
+
+    channel->address = (const volatile uint8_t *)address;
+    channel->encoding = encoding;
+    channel->period = period;
+    channel->due = uart_telemetry_now();
+
+    return uart_telemetry_count++;
+}
+
+/**
+ * @brief Change the sample period of a channel.
+ *
+ * @param channel Channel number returned by uart_telemetry_add().
+ * @param period Sample period in uart_telemetry_tick() periods (0 = off, max UART_TELEMETRY_PERIOD_MAX).
+ * @return 0 on success, 1 if the channel does not exist or the period is too long.
+ *
+ * @details
+ * The next sample is taken with the next uart_telemetry_process(), the new period starts from there.
+ */
+char uart_telemetry_rate(uint8_t channel, uint16_t period)
+{
+    if (channel >= uart_telemetry_count || period > UART_TELEMETRY_PERIOD_MAX)
+    {
+        return 1;
+    }
+
+    uart_telemetry_channels[channel].period = period;
+    uart_telemetry_channels[channel].due = uart_telemetry_now();
+    return 0;
+}
+
+/**
+ * @brief Advance the telemetry time base.
+ *
+ * @details
+ * Called from a periodic timer ISR (e.g. next to uart_tick()), sample periods are counted in calls of this function.
+ */
+void uart_telemetry_tick(void)
+{
+    uart_telemetry_time++;
+}
+
+/**
+ * @brief Sample the due channels and send them as one message.
+ *
+ * @return Number of sampled channels.
+ *
+ * @details
+ * Called from the main loop. Multi-byte values are copied with interrupts disabled, so variables written by an ISR are sampled consistently. A channel that is more than one period late restarts its period and the missed samples are counted (see uart_telemetry_lost()), telemetry never catches up with a burst.
+ */
+uint8_t uart_telemetry_process(void)
+{
+    uint16_t now = uart_telemetry_now();
+    uint8_t fill = UART_TELEMETRY_HEADER;
+    uint8_t samples = 0;
+    uint8_t index = uart_telemetry_next;
+
+    for (uint8_t i = 0; i < uart_telemetry_count; i++)
+    {
+        struct uart_telemetry_channel *channel = &uart_telemetry_channels[index];
+
+        if (channel->period && (int16_t)(now - channel->due) >= 0)
+        {
+            uint8_t code = channel->encoding & UART_TELEMETRY_SIZE;
+            uint8_t size = 1 << code;
+
+            // The next message starts with the channel that did not fit
+            if ((fill - UART_TELEMETRY_HEADER) + 1 + size > UART_TELEMETRY_MESSAGE_MAX)
+            {
+                break;
+            }
+
+            uart_telemetry_message[fill++] = (code << 6) | index;
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                for (uint8_t j = 0; j < size; j++)
+                {
+                    uart_telemetry_message[fill++] = channel->address[j];
+                }
+            }
+
+            channel->due += channel->period;
+
+            if ((int16_t)(now - channel->due) >= 0)
+            {
+                uart_telemetry_lost_count++;
+                channel->due = now + channel->period;
+            }
+            samples++;
+        }
+
+        if (++index >= uart_telemetry_count)
+        {
+            index = 0;
+        }
+    }
+    uart_telemetry_next = index;
+
+    if (samples)
+    {
+        uart_telemetry_message[0] = UART_TELEMETRY_ID;
+        uart_telemetry_message[1] = UART_TELEMETRY_STATUS;
+        uart_telemetry_message[2] = fill - 3;
+        uart_telemetry_message[3] = (uint8_t)now;
+        uart_telemetry_message[4] = (uint8_t)(now >> 8);
+
+        if (uart_frame_write(uart_telemetry_message, fill))
+        {
+            uart_telemetry_lost_count += samples;
+        }
+    }
+    return samples;
+}
+
+/**
+ * @brief Read and reset the number of lost samples.
+ *
+ * @return Number of samples missed by lateness or discarded with their message since the last call.
+ */
+uint16_t uart_telemetry_lost(void)
+{
+    uint16_t count = uart_telemetry_lost_count;
+
+    uart_telemetry_lost_count = 0;
+    return count;
+}
+
+#if UART_FRAME_RX > 0
+    /**
+     * @brief RPC method to query and change telemetry channels from the host.
+     *
+     * @param id Request ID.
+     * @param args Arguments: none, channel (1 byte) or channel and period (1 + 2 bytes).
+     * @param length Number of argument bytes.
+     * @param[out] result Number of channels (no arguments) or encoding and period (1 + 2 bytes) of the channel.
+     * @param[in,out] size Result length.
+     * @return UART_RPC_OK, UART_RPC_ERROR if the channel does not exist or the period is too long.
+     *
+     * @details
+     * Entry for the method table of uart_rpc_init(), with a period argument the period is changed first (see uart_telemetry_rate()).
+     *
+     * @code
+     * static const UART_RPC_Method rpc_methods[] PROGMEM = { rpc_echo, uart_telemetry_method };
+     * @endcode
+     */
+    uint8_t uart_telemetry_method(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size)
+    {
+        if (!length)
+        {
+            result[0] = uart_telemetry_count;
+            *size = 1;
+            return UART_RPC_OK;
+        }
+
+        uint8_t channel = args[0];
+
+        if (channel >= uart_telemetry_count)
+        {
+            return UART_RPC_ERROR;
+        }
+
+        if (length >= 3 && uart_telemetry_rate(channel, args[1] | ((uint16_t)args[2] << 8)))
+        {
+            return UART_RPC_ERROR;
+        }
+
+        result[0] = uart_telemetry_channels[channel].encoding;
+        result[1] = (uint8_t)uart_telemetry_channels[channel].period;
+        result[2] = (uint8_t)(uart_telemetry_channels[channel].period >> 8);
+        *size = 3;
+        return UART_RPC_OK;
+    }
+#endif
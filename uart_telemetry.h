@@ -0,0 +1,169 @@
+/**
+ * @file uart_telemetry.h
+ * @brief Header file with declarations of the periodic telemetry scheduler.
+ *
+ * This file provides a telemetry subsystem on top of UART frames. Variables are registered once with an encoding and a sample period, the scheduler packs all due samples into compact binary messages, so the bandwidth and CPU time of telemetry are fixed by configuration instead of by the number of printf() calls. Sample periods can be changed at runtime, also by the host through the RPC layer.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_TELEMETRY_H_
+#define UART_TELEMETRY_H_
+
+    /**
+     * @defgroup UART_Telemetry UART Telemetry Macros
+     * @brief Configuration macros and encodings of the telemetry scheduler.
+     *
+     * @details
+     * Samples leave in messages with the layout of an RPC response (see @ref UART_RPC), so they can share a frame with RPC responses (UART_FRAME_COALESCE) and a host RPC client separates them by their ID:
+     *
+     * Message: ID (UART_TELEMETRY_ID), status (UART_TELEMETRY_STATUS), length (1 byte), time (2 bytes), records.
+     * Record:  size code (bits 7-6: 0 = 1 byte, 1 = 2 bytes, 2 = 4 bytes) | channel (bits 5-0), value.
+     *
+     * Time is the uart_telemetry_tick() count when the message has been packed. Multi-byte values are little-endian (native AVR byte order).
+     */
+    /* @{ */
+    #ifndef UART_TELEMETRY_CHANNELS
+        /**
+         * @def UART_TELEMETRY_CHANNELS
+         * @brief Maximum number of registered variables (default 8, max 64).
+         */
+        #define UART_TELEMETRY_CHANNELS 8
+    #endif
+
+    #ifndef UART_TELEMETRY_MESSAGE_MAX
+        /**
+         * @def UART_TELEMETRY_MESSAGE_MAX
+         * @brief Maximum size of the records of one message in bytes (default 32, 5-250).
+         *
+         * @details
+         * uart_telemetry_process() sends at most one message per call, which bounds its run time. Due samples that do not fit are sent with the next call.
+         */
+        #define UART_TELEMETRY_MESSAGE_MAX 32
+    #endif
+
+    #ifndef UART_TELEMETRY_ID
+        /**
+         * @def UART_TELEMETRY_ID
+         * @brief Message ID of telemetry messages (default 0xFF), reserved for telemetry on the host.
+         */
+        #define UART_TELEMETRY_ID 0xFF
+    #endif
+
+    #if UART_TELEMETRY_CHANNELS < 1 || UART_TELEMETRY_CHANNELS > 64
+        #error "UART_TELEMETRY_CHANNELS has to be 1-64"
+    #endif
+
+    #if UART_TELEMETRY_MESSAGE_MAX < 5 || UART_TELEMETRY_MESSAGE_MAX > 250
+        #error "UART_TELEMETRY_MESSAGE_MAX has to be 5-250"
+    #endif
+
+    /**
+     * @def UART_TELEMETRY_STATUS
+     * @brief Status byte of telemetry messages (unsolicited message).
+     */
+    #define UART_TELEMETRY_STATUS 0x80
+
+    /**
+     * @def UART_TELEMETRY_HEADER
+     * @brief Size of the message header (ID, status, length, time) in bytes.
+     */
+    #define UART_TELEMETRY_HEADER 5
+
+    /**
+     * @def UART_TELEMETRY_INVALID
+     * @brief Returned by uart_telemetry_add() if all channels are in use or the channel is invalid.
+     */
+    #define UART_TELEMETRY_INVALID 0xFF
+
+    /**
+     * @def UART_TELEMETRY_PERIOD_MAX
+     * @brief Longest sample period in uart_telemetry_tick() periods, due times are compared as int16_t.
+     */
+    #define UART_TELEMETRY_PERIOD_MAX 32767
+
+    /**
+     * @def UART_TELEMETRY_SIZE
+     * @brief Mask of the size code (value size is 1 << code bytes) inside an encoding.
+     */
+    #define UART_TELEMETRY_SIZE 0x03
+
+    /**
+     * @def UART_TELEMETRY_U8
+     * @brief Encoding: unsigned 8-bit value.
+     */
+    #define UART_TELEMETRY_U8 0x00
+
+    /**
+     * @def UART_TELEMETRY_U16
+     * @brief Encoding: unsigned 16-bit value.
+     */
+    #define UART_TELEMETRY_U16 0x01
+
+    /**
+     * @def UART_TELEMETRY_U32
+     * @brief Encoding: unsigned 32-bit value.
+     */
+    #define UART_TELEMETRY_U32 0x02
+
+    /**
+     * @def UART_TELEMETRY_S8
+     * @brief Encoding: signed 8-bit value.
+     */
+    #define UART_TELEMETRY_S8 0x04
+
+    /**
+     * @def UART_TELEMETRY_S16
+     * @brief Encoding: signed 16-bit value.
+     */
+    #define UART_TELEMETRY_S16 0x05
+
+    /**
+     * @def UART_TELEMETRY_S32
+     * @brief Encoding: signed 32-bit value.
+     */
+    #define UART_TELEMETRY_S32 0x06
+
+    /**
+     * @def UART_TELEMETRY_FLOAT
+     * @brief Encoding: IEEE 754 single precision value.
+     */
+    #define UART_TELEMETRY_FLOAT 0x0A
+    /* @} */
+
+    #include <stdint.h>
+
+    #include "uart.h"
+
+    #if UART_FRAME == 0
+        #error "uart_telemetry requires UART_FRAME > 0"
+    #elif UART_FRAME_LENGTH_BYTES == 1 && (UART_TELEMETRY_HEADER + UART_TELEMETRY_MESSAGE_MAX) > 255
+        #error "UART_TELEMETRY_MESSAGE_MAX does not fit the frame length"
+    #endif
+
+    uint8_t uart_telemetry_add(const volatile void *address, uint8_t encoding, uint16_t period);
+    char uart_telemetry_rate(uint8_t channel, uint16_t period);
+    void uart_telemetry_tick(void);
+    uint8_t uart_telemetry_process(void);
+    uint16_t uart_telemetry_lost(void);
+
+    #if UART_FRAME_RX > 0
+        #include "uart_rpc.h"
+
+        #if UART_RPC_RESULT_MAX < 3
+            #error "uart_telemetry_method() requires UART_RPC_RESULT_MAX >= 3"
+        #endif
+
+        uint8_t uart_telemetry_method(uint8_t id, const uint8_t *args, uint8_t length, uint8_t *result, uint8_t *size);
+    #endif
+
+#endif /* UART_TELEMETRY_H_ */
@@ -0,0 +1,208 @@
+/**
+ * @file uart_tiny.h
+ * @brief Header file with the size-optimized UART profile for bootloaders.
+ *
+ * This file provides a minimal, header-only UART driver with a fixed 8N1 frame, polled transmission and reception and no stdio support. It is included instead of uart.h, uart.c is not linked, so only the inline code of the used functions ends up in flash memory.
+ *
+ * @author g.raf
+ * @date 2026-10-18
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file mostly becomes part of larger projects and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/hal-avr-mega "AVR ATmega GitHub Repository"
+ */
+
+#ifndef UART_TINY_H_
+#define UART_TINY_H_
+
+    /**
+     * @defgroup UART_Tiny UART Tiny Profile
+     * @brief Configuration macros and flash budget of the bootloader profile.
+     *
+     * @details
+     * Flash budget (avr-gcc -Os, ATmega8/16/32, one call site of each function), at most 60 bytes in total. The numbers per function are estimated from the instruction sequences, not measured:
+     * - uart_tiny_init(): 10-16 bytes (baud rate registers, U2X, enable bits)
+     * - uart_tiny_putchar(): 6 bytes (UDRE poll and UDR write)
+     * - uart_tiny_getchar(): 6 bytes (RXC poll and UDR read)
+     * - uart_tiny_receive(): 14 bytes (RXC poll, one merged error check and UDR read)
+     *
+     * Every additional call site repeats the inline code, a bootloader with many call sites wraps the functions into its own noinline functions. Only the total is measured, by tools/uart_size.py (e.g. "tools/uart_size.py --mcu atmega16 --f-cpu 16000000 --baudrate 115200"), which fails above the budget.
+     *
+     * @code
+     * #define F_CPU 16000000UL
+     * #define UART_BAUDRATE 115200UL
+     * #include "uart_tiny.h"
+     *
+     * uart_tiny_init();
+     *
+     * for (;;)
+     * {
+     *     unsigned char data;
+     *
+     *     if (!uart_tiny_receive(&data))
+     *     {
+     *         uart_tiny_putchar(data);
+     *     }
+     * }
+     * @endcode
+     */
+    /* @{ */
+
+    #ifndef F_CPU
+        /**
+         * @def F_CPU
+         * @brief System clock frequency definition (default 12 MHz).
+         */
+        #define F_CPU 12000000UL
+    #endif
+
+    #ifndef UART_BAUDRATE
+        /**
+         * @def UART_BAUDRATE
+         * @brief UART communication baud rate (default 9600).
+         */
+        #define UART_BAUDRATE 9600UL
+    #endif
+
+    #ifndef BAUD
+        // Required for setbaud.h
+        #define BAUD UART_BAUDRATE
+    #endif
+
+    #ifndef UART_TINY_RESET_STATE
+        /**
+         * @def UART_TINY_RESET_STATE
+         * @brief The USART registers are in their reset state when uart_tiny_init() is called (default 1).
+         *
+         * @details
+         * After reset UCSRC already selects asynchronous 8N1 and U2X is cleared, so uart_tiny_init() skips writing them. Set to 0 if the bootloader is also entered from the running application (e.g. by a jump instead of a watchdog reset), then both registers are written (+4-6 bytes).
+         */
+        #define UART_TINY_RESET_STATE 1
+    #endif
+
+    #ifndef UART_TINY_HANDOVER
+        /**
+         * @def UART_TINY_HANDOVER
+         * @brief Enables uart_tiny_handover() (0 = disabled, default; 1 = enabled).
+         *
+         * @details
+         * Defines the handover record of uart_handover.h in this translation unit, include uart_tiny.h with UART_TINY_HANDOVER > 0 only once per bootloader.
+         */
+        #define UART_TINY_HANDOVER 0
+    #endif
+    /* @} */
+
+    #include <avr/io.h>
+    #include <util/setbaud.h>
+
+    #if UART_TINY_HANDOVER > 0
+        #include "uart_handover.h"
+
+        static UART_Handover uart_tiny_record __attribute__((section(UART_HANDOVER_SECTION), used));
+    #endif
+
+    /**
+     * @brief Initialize the USART with 8N1 and enable receiver and transmitter.
+     */
+    static inline void uart_tiny_init(void)
+    {
+        UBRRH = UBRRH_VALUE;            // Calculated through setbaud.h
+        UBRRL = UBRRL_VALUE;            // Calculated through setbaud.h
+
+        #if USE_2X
+            UCSRA = (1<<U2X);           // Setup 8 samples/bit
+        #elif UART_TINY_RESET_STATE == 0
+            UCSRA = 0;                  // Setup 16 samples/bit
+        #endif
+
+        #if UART_TINY_RESET_STATE == 0
+            UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0);
+        #endif
+
+        UCSRB = (1<<RXEN) | (1<<TXEN);
+    }
+
+    /**
+     * @brief Disable the USART, e.g. before the bootloader starts the application.
+     */
+    static inline void uart_tiny_disable(void)
+    {
+        UCSRB = 0;
+    }
+
+    /**
+     * @brief Transmit a character.
+     *
+     * @param data Character to transmit.
+     */
+    static inline void uart_tiny_putchar(unsigned char data)
+    {
+        while (!(UCSRA & (1<<UDRE)))
+        {
+            ;
+        }
+        UDR = data;
+    }
+
+    /**
+     * @brief Receive a character without error check.
+     *
+     * @return Received character.
+     */
+    static inline unsigned char uart_tiny_getchar(void)
+    {
+        while (!(UCSRA & (1<<RXC)))
+        {
+            ;
+        }
+        return UDR;
+    }
+
+    /**
+     * @brief Receive a character with error check.
+     *
+     * @param[out] data Received character, also stored on an error.
+     * @return 0 if the character has been received correctly, otherwise the FE/DOR/UPE bits of UCSRA.
+     *
+     * @details
+     * Frame error, data overrun and parity error are checked with one mask instead of one branch each. The status has to be read before UDR, reading UDR clears it.
+     */
+    static inline unsigned char uart_tiny_receive(unsigned char *data)
+    {
+        unsigned char status;
+
+        while (!((status = UCSRA) & (1<<RXC)))
+        {
+            ;
+        }
+
+        *data = UDR;
+        return status & ((1<<FE) | (1<<DOR) | (1<<UPE));
+    }
+
+    #if UART_TINY_HANDOVER > 0
+        /**
+         * @brief Leave the current baud rate to the application.
+         *
+         * @details
+         * Records UBRR and U2X as they are programmed now, also after a runtime baud rate detection, together with the fixed 8N1 frame format. Call right before the jump into the application, the USART has to stay enabled.
+         */
+        static inline void uart_tiny_handover(void)
+        {
+            // UBRRL first, UBRRH/UCSRC only returns UCSRC on a directly repeated read
+            uint16_t ubrr = UBRRL;
+
+            ubrr |= (uint16_t)(UBRRH & 0x0F) << 8;
+
+            uart_tiny_record.ubrr = ubrr;
+            uart_tiny_record.ucsra = UCSRA & (1<<U2X);
+            uart_tiny_record.ucsrc = (1<<UCSZ1) | (1<<UCSZ0);
+            uart_tiny_record.magic = UART_HANDOVER_MAGIC;
+        }
+    #endif
+
+#endif /* UART_TINY_H_ */